@@ -32,6 +32,21 @@ static cl::opt<ProgActions> ProgAction(
                clEnumValN(DumpTokens, "dumptokens",
                           "Run preprocessor, dump internal rep of tokens")));
 
+static cl::opt<BufferLoadPolicy> SourceBuffers(
+    "fsource-buffers", cl::desc("How to load source files:"),
+    cl::init(BufferLoadPolicy::Threshold),
+    cl::values(clEnumValN(BufferLoadPolicy::Threshold, "auto",
+                          "Map files of at least -fmmap-threshold bytes"),
+               clEnumValN(BufferLoadPolicy::AlwaysMap, "mmap",
+                          "Map every file"),
+               clEnumValN(BufferLoadPolicy::AlwaysRead, "read",
+                          "Read every file into memory")));
+
+static cl::opt<unsigned> MMapThreshold(
+    "fmmap-threshold", cl::value_desc("bytes"),
+    cl::init(SourceManager::DefaultMapThreshold),
+    cl::desc("Smallest file mapped by -fsource-buffers=auto"));
+
 //===----------------------------------------------------------------------===//
 // Our DiagnosticClient implementation
 //===----------------------------------------------------------------------===//
@@ -77,7 +92,7 @@ class DiagnosticPrinterSTDERR : public DiagnosticClient {
 };
 
 void DiagnosticPrinterSTDERR::PrintIncludeStack(SourceLocation Pos) {
-  unsigned FileID = Pos.getFileID();
+  unsigned FileID = SourceMgr.getFileID(Pos);
   if (FileID == 0)
     return;
 
@@ -102,19 +117,19 @@ void DiagnosticPrinterSTDERR::HandleDiagnostic(Diagnostic::Level Level,
   if (Pos.isValid()) {
     LineNo = SourceMgr.getLineNumber(Pos);
     FilePos = SourceMgr.getFilePos(Pos);
-    FileID = Pos.getFileID();
+    FileID = SourceMgr.getFileID(Pos);
 
     // First, if this diagnostic is not in the main file, print out the
     // "included from" lines.
-    if (LastWarningLoc != SourceMgr.getIncludeLoc(Pos.getFileID())) {
-      LastWarningLoc = SourceMgr.getIncludeLoc(Pos.getFileID());
+    if (LastWarningLoc != SourceMgr.getIncludeLoc(FileID)) {
+      LastWarningLoc = SourceMgr.getIncludeLoc(FileID);
       PrintIncludeStack(LastWarningLoc);
     }
 
     // Compute the column number.  Rewind from the current position to the start
     // of the line.
     ColNo = SourceMgr.getColumnNumber(Pos);
-    LineStart = FilePos - ColNo - 1;  // Column # is 1-based
+    LineStart = FilePos - (ColNo - 1);  // Column # is 1-based
 
     // Compute the line end.  Scan forward from the error position to the end of
     // the line.
@@ -364,6 +379,11 @@ static void InitializePredefinedMacros(Preprocessor& PP,
 static cl::opt<bool> nostdinc(
     "nostdinc", cl::desc("Disable standard #include directories"));
 
+static cl::opt<bool> CacheDirListings(
+    "fcache-dir-listings",
+    cl::desc("Read each #include directory once instead of stat'ing every "
+             "failed lookup in it"));
+
 // Various command line options.  These four add directories to each chain.
 static cl::list<std::string> I_dirs(
     "I", cl::value_desc("directory"), cl::Prefix,
@@ -569,8 +589,6 @@ void DoPrintPreprocessedInput(Preprocessor& PP) {
     // If this token is at the start of a line.  Emit the \n and indentation.
     // FIXME: this shouldn't use the isAtStartOfLine flag.  This should use a
     // "newline callback" from the lexer.
-    // FIXME: For some tests, this fails just because there is no col# info from
-    // macro expansions!
     if (Tok.isAtStartOfLine()) {
       if (!isFirstToken)
         std::cout << "\n";
@@ -597,11 +615,11 @@ void DoPrintPreprocessedInput(Preprocessor& PP) {
     isFirstToken = false;
 
     if (Tok.getLength() < 256) {
-      unsigned Len = Lexer::getSpelling(Tok, Buffer, PP.getLangOptions());
+      unsigned Len = PP.getSpelling(Tok, Buffer);
       Buffer[Len] = 0;
       std::cout << Buffer;
     } else {
-      std::string S = Lexer::getSpelling(Tok, PP.getLangOptions());
+      std::string S = PP.getSpelling(Tok);
       std::cout << S;
     }
   } while (Tok.getKind() != tok::eof);
@@ -616,8 +634,22 @@ static cl::opt<std::string> InputFilename(cl::Positional,
                                           cl::desc("<input file>"),
                                           cl::init("-"));
 
+static cl::opt<bool> LazyMacroBodies(
+    "flazy-macro-bodies",
+    cl::desc("Lex the body of a macro when it is first expanded instead of "
+             "when it is defined"));
+
+static cl::opt<bool> CacheMacroExpansions(
+    "fcache-macro-expansions",
+    cl::desc("Reuse the full expansion of an object-like macro until a macro "
+             "is defined or undefined"));
+
 void PrintIdentStats();
 
+/// TokenBatchSize - How many tokens the -Eonly and -dumptokens loops ask the
+/// preprocessor for at a time.
+static const unsigned TokenBatchSize = 256;
+
 int main(int argc, char** argv) {
   std::vector<const char*> Args;
   for (const char* A : llvm::ArrayRef(argv, argc))
@@ -629,6 +661,7 @@ int main(int argc, char** argv) {
   /// Create a SourceManager object.  This tracks and owns all the file buffers
   /// allocated to the program.
   SourceManager SourceMgr;
+  SourceMgr.setBufferLoadPolicy(SourceBuffers, MMapThreshold);
 
   // Print diagnostics to stderr.
   DiagnosticPrinterSTDERR OurDiagnosticClient(SourceMgr);
@@ -648,9 +681,12 @@ int main(int argc, char** argv) {
 
   // Create a file manager object to provide access to and cache the filesystem.
   FileManager FileMgr;
+  FileMgr.setCacheDirectoryListings(CacheDirListings);
 
   // Set up the preprocessor with these options.
   Preprocessor PP(OurDiagnostics, Options, FileMgr, SourceMgr);
+  PP.setLazyMacroBodies(LazyMacroBodies);
+  PP.setCacheMacroExpansions(CacheMacroExpansions);
 
   // Install things like __POWERPC__, __GNUC__, etc into the macro table.
   std::vector<char> PrologMacros;
@@ -662,9 +698,6 @@ int main(int argc, char** argv) {
   // Read any files specified by -imacros or -include.
   ReadPrologFiles(PP, PrologMacros);
 
-  // Set up keywords.
-  PP.AddKeywords();
-
   // Now that we have emitted the predefined macros, #includes, etc into
   // PrologMacros, preprocess it to populate the initial preprocessor state.
   {
@@ -674,7 +707,7 @@ int main(int argc, char** argv) {
     llvm::MemoryBuffer* SB =
         llvm::MemoryBuffer::getMemBuffer(&PrologMacros.front(),
                                          &PrologMacros.back(), "<predefines>")
-            .get();
+            .release();
     assert(SB && "Cannot fail to create predefined source buffer");
     unsigned FileID = SourceMgr.createFileIDForMemBuffer(SB);
     assert(FileID && "Could not create FileID for predefines?");
@@ -700,9 +733,10 @@ int main(int argc, char** argv) {
       return 1;
     }
   } else {
-    llvm::MemoryBuffer* SB = llvm::MemoryBuffer::getSTDIN().get().get();
-    if (SB)
-      MainFileID = SourceMgr.createFileIDForMemBuffer(SB);
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer> > SB =
+        llvm::MemoryBuffer::getSTDIN();
+    if (SB && *SB)
+      MainFileID = SourceMgr.createFileIDForMemBuffer(SB->release());
     if (MainFileID == 0) {
       std::cerr << "Error reading standard input!  Empty?\n";
       return 1;
@@ -714,10 +748,10 @@ int main(int argc, char** argv) {
 
   switch (ProgAction) {
     case RunPreprocessorOnly: {  // Just lex as fast as we can, no output.
-      LexerToken Tok;
-      do {
-        PP.Lex(Tok);
-      } while (Tok.getKind() != tok::eof);
+      LexerToken Toks[TokenBatchSize];
+      while (PP.LexBatch(Toks, TokenBatchSize) == TokenBatchSize &&
+             Toks[TokenBatchSize - 1].getKind() != tok::eof)
+        ;
       break;
     }
 
@@ -726,12 +760,15 @@ int main(int argc, char** argv) {
       break;
 
     case DumpTokens: {  // Token dump mode.
-      LexerToken Tok;
+      LexerToken Toks[TokenBatchSize];
+      unsigned NumToks;
       do {
-        PP.Lex(Tok);
-        Tok.dump(Options, true);
-        std::cerr << "\n";
-      } while (Tok.getKind() != tok::eof);
+        NumToks = PP.LexBatch(Toks, TokenBatchSize);
+        for (unsigned i = 0; i != NumToks; ++i) {
+          Toks[i].dump(SourceMgr, Options, true);
+          std::cerr << "\n";
+        }
+      } while (Toks[NumToks - 1].getKind() != tok::eof);
       break;
     }
   }
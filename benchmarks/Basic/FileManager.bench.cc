@@ -0,0 +1,117 @@
+#include "tinyclang/Basic/FileManager.h"
+
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// IncludeTree - A scratch directory laid out like an include-heavy build: a
+/// number of search directories, with every header living in exactly one of
+/// them.  Probes walks the search path for each header the way
+/// Preprocessor::LookupFile does, so most of them are misses.
+struct IncludeTree {
+  enum { NumSearchDirs = 32, NumHeaders = 256 };
+
+  std::string Root;
+  std::vector<std::string> Probes;
+
+  IncludeTree() {
+    char tmpl[] = "/tmp/tinyclang-fm-bench-XXXXXX";
+    Root = mkdtemp(tmpl);
+    for (unsigned d = 0; d != NumSearchDirs; ++d) {
+      std::filesystem::create_directory(Root + "/inc" + std::to_string(d));
+    }
+    for (unsigned h = 0; h != NumHeaders; ++h) {
+      std::string header = "/header" + std::to_string(h) + ".h";
+      unsigned home_dir = h % NumSearchDirs;
+      std::ofstream(Root + "/inc" + std::to_string(home_dir) + header);
+      for (unsigned d = 0; d <= home_dir; ++d) {
+        Probes.push_back(Root + "/inc" + std::to_string(d) + header);
+      }
+    }
+  }
+
+  ~IncludeTree() { std::filesystem::remove_all(Root); }
+};
+
+auto getTree() -> const IncludeTree& {
+  static IncludeTree tree;
+  return tree;
+}
+
+/// BM_FileManagerProbe - Repeated #include probes against a warm FileManager.
+void BM_FileManagerProbe(benchmark::State& state) {
+  const IncludeTree& tree = getTree();
+  tinyclang::FileManager fm;
+  for (const std::string& path : tree.Probes) {
+    fm.getFile(path);
+  }
+
+  for (auto _ : state) {
+    for (const std::string& path : tree.Probes) {
+      benchmark::DoNotOptimize(fm.getFile(path));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * tree.Probes.size());
+}
+BENCHMARK(BM_FileManagerProbe);
+
+/// BM_StdMapProbe - The same probes against the lower_bound/compare lookup on
+/// a std::map that FileManager used to do, for comparison.
+void BM_StdMapProbe(benchmark::State& state) {
+  const IncludeTree& tree = getTree();
+  std::map<std::string, const void*> file_entries;
+  for (const std::string& path : tree.Probes) {
+    file_entries.insert(std::make_pair(path, nullptr));
+  }
+
+  for (auto _ : state) {
+    for (const std::string& path : tree.Probes) {
+      auto i = file_entries.lower_bound(path);
+      if (i != file_entries.end() && i->first == path) {
+        benchmark::DoNotOptimize(i->second);
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * tree.Probes.size());
+}
+BENCHMARK(BM_StdMapProbe);
+
+/// BM_FileManagerColdProbe - Probes against a fresh FileManager, including the
+/// stat() calls for every miss.
+void BM_FileManagerColdProbe(benchmark::State& state) {
+  const IncludeTree& tree = getTree();
+  for (auto _ : state) {
+    tinyclang::FileManager fm;
+    for (const std::string& path : tree.Probes) {
+      benchmark::DoNotOptimize(fm.getFile(path));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * tree.Probes.size());
+}
+BENCHMARK(BM_FileManagerColdProbe);
+
+/// BM_FileManagerColdProbeDirListings - Like BM_FileManagerColdProbe, but
+/// failing probes are answered from cached directory listings.
+void BM_FileManagerColdProbeDirListings(benchmark::State& state) {
+  const IncludeTree& tree = getTree();
+  for (auto _ : state) {
+    tinyclang::FileManager fm;
+    fm.setCacheDirectoryListings(true);
+    for (const std::string& path : tree.Probes) {
+      benchmark::DoNotOptimize(fm.getFile(path));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * tree.Probes.size());
+}
+BENCHMARK(BM_FileManagerColdProbeDirListings);
+
+}  // namespace
+
+BENCHMARK_MAIN();
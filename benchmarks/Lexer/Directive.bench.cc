@@ -0,0 +1,364 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <string>
+
+#include "llvm/Support/MemoryBuffer.h"
+#include "tinyclang/Basic/FileManager.h"
+#include "tinyclang/Diagnostic/Diagnostic.h"
+#include "tinyclang/Lexer/Lexer.h"
+#include "tinyclang/Lexer/Preprocessor.h"
+#include "tinyclang/Source/SourceManager.h"
+
+namespace {
+
+/// NumAllocations - The number of calls to the global operator new so far.
+unsigned long NumAllocations = 0;
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  ++NumAllocations;
+  if (void* ptr = std::malloc(size ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+class IgnoreDiagnostics : public tinyclang::DiagnosticClient {
+ public:
+  void HandleDiagnostic(tinyclang::Diagnostic::Level, tinyclang::SourceLocation,
+                        tinyclang::diag::kind, const std::string&) override {}
+};
+
+/// getGuardedHeader - Return the absolute path of a header wrapped in a
+/// multiple-include guard, written to the temporary directory.  All it has
+/// besides the guard is the declaration "int guarded;".
+auto getGuardedHeader() -> const std::string& {
+  static const std::string path = [] {
+    std::filesystem::path p = std::filesystem::temp_directory_path() /
+                              "tinyclang_directive_bench.h";
+    std::ofstream(p) << "#ifndef GUARDED_H\n#define GUARDED_H\n"
+                        "int guarded;\n#endif\n";
+    return p.string();
+  }();
+  return path;
+}
+
+/// DirectiveCorpus - A buffer of the directives system headers are full of,
+/// both live and inside an #if 0 block, NumCopies times over, after an
+/// #include of the guarded header.  Some directive names are split by an
+/// escaped newline, which makes their spelling need cleaning.  The live
+/// #includes are of the guarded header again, which is skipped.  #error is
+/// only skipped: when live it reports a diagnostic, which builds its message.
+struct DirectiveCorpus {
+  enum { NumCopies = 2000 };
+
+  std::string Text;
+  unsigned NumDirectives = 0;
+
+  explicit DirectiveCorpus(bool skipped) {
+    static const char* const live_chunk =
+        "#ifdef FOO\n#else\n#endif\n"
+        "#ifndef FOO\n#endif\n"
+        "#if 1\n#elif 2\n#endif\n"
+        "#if defined(FOO) && 42 > 7\n#endif\n"
+        "#define BAR(x, y) ((x) + (y) * 2)\n"
+        "#undef BAR\n"
+        "#include \"@\"\n"
+        "#pragma something_unknown\n"
+        "#if 1\n#end\\\nif\n";
+    static const char* const skipped_chunk =
+        "#if 0\n"
+        "#ifdef FOO\n#else\n#endif\n"
+        "#define BAR 1\n#undef BAR\n"
+        "#include <nothing.h>\n"
+        "#pragma once\n"
+        "#error not reached\n"
+        "#elif 0\n"
+        "#el\\\nse\n"
+        "#end\\\nif\n";
+    std::string chunk = skipped ? skipped_chunk : live_chunk;
+    std::string::size_type at = chunk.find('@');
+    if (at != std::string::npos) {
+      chunk.replace(at, 1, getGuardedHeader());
+    }
+
+    for (unsigned i = 0; i != NumCopies; ++i) {
+      Text += chunk;
+    }
+    for (char c : Text) {
+      NumDirectives += c == '#';
+    }
+    Text = "#include \"" + getGuardedHeader() + "\"\n" + Text;
+  }
+};
+
+auto getCorpus(bool skipped) -> const DirectiveCorpus& {
+  static DirectiveCorpus live(false), skipping(true);
+  return skipped ? skipping : live;
+}
+
+/// BM_Directives - Preprocess a buffer of nothing but directives, counting the
+/// heap allocations made once the guarded header has been read.  The only ones
+/// left are the amortized growth of the arena and token buffer that live
+/// #defines store their macros in.
+void BM_Directives(benchmark::State& state) {
+  const DirectiveCorpus& corpus = getCorpus(state.range(0));
+  tinyclang::LangOptions lang_opts;
+  lang_opts.Trigraphs = 1;
+  lang_opts.C99 = 1;
+  IgnoreDiagnostics diag_client;
+  tinyclang::Diagnostic diags(diag_client);
+  tinyclang::FileManager file_mgr;
+
+  unsigned long num_allocations = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    tinyclang::SourceManager source_mgr;
+    {
+      tinyclang::Preprocessor pp(diags, lang_opts, file_mgr, source_mgr);
+      pp.EnterSourceFile(source_mgr.createFileIDForMemBuffer(
+                             llvm::MemoryBuffer::getMemBuffer(corpus.Text)
+                                 .release()),
+                         0);
+
+      // Read the guarded header untimed: entering a file allocates.
+      tinyclang::LexerToken tok;
+      do {
+        pp.Lex(tok);
+      } while (tok.getKind() != tinyclang::tok::semi);
+      unsigned long allocations_before = NumAllocations;
+      state.ResumeTiming();
+
+      do {
+        pp.Lex(tok);
+      } while (tok.getKind() != tinyclang::tok::eof);
+
+      state.PauseTiming();
+      num_allocations += NumAllocations - allocations_before;
+    }
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed(state.iterations() * corpus.NumDirectives);
+  state.counters["allocs/directive"] = benchmark::Counter(
+      num_allocations / (double)corpus.NumDirectives,
+      benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_Directives)->ArgName("skipped")->Arg(0)->Arg(1);
+
+/// DefineCorpus - The #defines of a big system header, NumMacros of them, with
+/// one in every UseStride of the macros used after them.
+struct DefineCorpus {
+  enum { NumMacros = 20000, UseStride = 16 };
+
+  std::string Text;
+
+  DefineCorpus() {
+    for (unsigned i = 0; i != NumMacros; ++i) {
+      Text += "#define MACRO_" + std::to_string(i) + " ((unsigned)" +
+              std::to_string(i * 7919 % 65536) + " << " +
+              std::to_string(i % 16) + ")  /* flag " + std::to_string(i) +
+              " */\n";
+    }
+    for (unsigned i = 0; i < NumMacros; i += UseStride) {
+      Text += "int x" + std::to_string(i) + " = MACRO_" + std::to_string(i) +
+              ";\n";
+    }
+  }
+};
+
+/// BM_Defines - Preprocess a buffer of #defines, most of which are never used,
+/// with the macro bodies lexed when they are defined or when first expanded.
+void BM_Defines(benchmark::State& state) {
+  static const DefineCorpus corpus;
+  tinyclang::LangOptions lang_opts;
+  lang_opts.Trigraphs = 1;
+  lang_opts.C99 = 1;
+  IgnoreDiagnostics diag_client;
+  tinyclang::Diagnostic diags(diag_client);
+  tinyclang::FileManager file_mgr;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    tinyclang::SourceManager source_mgr;
+    {
+      tinyclang::Preprocessor pp(diags, lang_opts, file_mgr, source_mgr);
+      pp.setLazyMacroBodies(state.range(0));
+      pp.EnterSourceFile(source_mgr.createFileIDForMemBuffer(
+                             llvm::MemoryBuffer::getMemBuffer(corpus.Text)
+                                 .release()),
+                         0);
+      state.ResumeTiming();
+
+      tinyclang::LexerToken tok;
+      do {
+        pp.Lex(tok);
+      } while (tok.getKind() != tinyclang::tok::eof);
+
+      state.PauseTiming();
+    }
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed(state.iterations() * DefineCorpus::NumMacros);
+  state.SetBytesProcessed(state.iterations() * corpus.Text.size());
+}
+BENCHMARK(BM_Defines)->ArgName("lazy")->Arg(0)->Arg(1);
+
+/// InvocationCorpus - The function-like macros of everyday code, invoked
+/// NumLines times: nested invocations, parameters used more than once,
+/// stringizing, pasting and variadic arguments.
+struct InvocationCorpus {
+  enum { NumLines = 5000, ExpansionsPerLine = 8 };
+
+  std::string Text;
+
+  InvocationCorpus() {
+    Text =
+        "#define MIN(a, b) ((a) < (b) ? (a) : (b))\n"
+        "#define SQ(x) ((x) * (x))\n"
+        "#define ARR_SIZE(a) (sizeof(a) / sizeof((a)[0]))\n"
+        "#define LOG(fmt, ...) log_printf(fmt, ## __VA_ARGS__)\n"
+        "#define CAT(a, b) a ## b\n"
+        "#define STR(x) #x\n"
+        "#define ZERO() 0\n";
+    for (unsigned i = 0; i != NumLines; ++i) {
+      Text +=
+          "x = MIN(SQ(i), MIN(j, k)) + ARR_SIZE(tab) + CAT(v, 1) + ZERO();"
+          " LOG(\"%s\", STR(y + 1));\n";
+    }
+  }
+};
+
+/// BM_FunctionMacros - Preprocess a buffer of function-like macro invocations,
+/// counting the heap allocations made once the macros are defined.
+void BM_FunctionMacros(benchmark::State& state) {
+  static const InvocationCorpus corpus;
+  tinyclang::LangOptions lang_opts;
+  lang_opts.Trigraphs = 1;
+  lang_opts.C99 = 1;
+  IgnoreDiagnostics diag_client;
+  tinyclang::Diagnostic diags(diag_client);
+  tinyclang::FileManager file_mgr;
+
+  unsigned long num_allocations = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    tinyclang::SourceManager source_mgr;
+    {
+      tinyclang::Preprocessor pp(diags, lang_opts, file_mgr, source_mgr);
+      pp.EnterSourceFile(source_mgr.createFileIDForMemBuffer(
+                             llvm::MemoryBuffer::getMemBuffer(corpus.Text)
+                                 .release()),
+                         0);
+
+      // Lex the #defines and the first line untimed, which warms up the
+      // expansion buffers.
+      tinyclang::LexerToken tok;
+      for (unsigned semis = 0; semis != 2;) {
+        pp.Lex(tok);
+        semis += tok.getKind() == tinyclang::tok::semi;
+      }
+      unsigned long allocations_before = NumAllocations;
+      state.ResumeTiming();
+
+      do {
+        pp.Lex(tok);
+      } while (tok.getKind() != tinyclang::tok::eof);
+
+      state.PauseTiming();
+      num_allocations += NumAllocations - allocations_before;
+    }
+    state.ResumeTiming();
+  }
+
+  unsigned num_expansions = (InvocationCorpus::NumLines - 1) *
+                            InvocationCorpus::ExpansionsPerLine;
+  state.SetItemsProcessed(state.iterations() * num_expansions);
+  state.counters["allocs/expansion"] = benchmark::Counter(
+      num_allocations / (double)num_expansions,
+      benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_FunctionMacros);
+
+/// ObjectMacroCorpus - The object-like macros of the C library headers, which
+/// expand through a few levels of other macros, used NumLines times.
+struct ObjectMacroCorpus {
+  enum { NumLines = 5000, ExpansionsPerLine = 7 };
+
+  std::string Text;
+
+  ObjectMacroCorpus() {
+    Text =
+        "#define __INT_MAX__ 0x7fffffff\n"
+        "#define INT_MAX __INT_MAX__\n"
+        "#define INT_MIN (-INT_MAX - 1)\n"
+        "#define UINT64_MAX (18446744073709551615UL)\n"
+        "#define SIZE_MAX UINT64_MAX\n"
+        "#define NULL ((void *)0)\n"
+        "#define __LEAF , __leaf__\n"
+        "#define __THROW __attribute__ ((__nothrow__ __LEAF))\n"
+        "#define __attribute_warn_unused_result__ \\\n"
+        "  __attribute__ ((__warn_unused_result__))\n"
+        "#define __wur __attribute_warn_unused_result__\n"
+        "#define __attribute_deprecated__ __attribute__ ((__deprecated__))\n";
+    for (unsigned i = 0; i != NumLines; ++i) {
+      Text +=
+          "extern int f(int) __THROW __wur; x = INT_MIN + INT_MAX + SIZE_MAX;"
+          " void *p = NULL; __attribute_deprecated__ int g;\n";
+    }
+  }
+};
+
+/// BM_ObjectMacros - Preprocess a buffer of object-like macro uses, with their
+/// full expansions cached or not.
+void BM_ObjectMacros(benchmark::State& state) {
+  static const ObjectMacroCorpus corpus;
+  tinyclang::LangOptions lang_opts;
+  lang_opts.Trigraphs = 1;
+  lang_opts.C99 = 1;
+  IgnoreDiagnostics diag_client;
+  tinyclang::Diagnostic diags(diag_client);
+  tinyclang::FileManager file_mgr;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    tinyclang::SourceManager source_mgr;
+    {
+      tinyclang::Preprocessor pp(diags, lang_opts, file_mgr, source_mgr);
+      pp.setCacheMacroExpansions(state.range(0));
+      pp.EnterSourceFile(source_mgr.createFileIDForMemBuffer(
+                             llvm::MemoryBuffer::getMemBuffer(corpus.Text)
+                                 .release()),
+                         0);
+      state.ResumeTiming();
+
+      tinyclang::LexerToken tok;
+      do {
+        pp.Lex(tok);
+      } while (tok.getKind() != tinyclang::tok::eof);
+
+      state.PauseTiming();
+    }
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed(state.iterations() * ObjectMacroCorpus::NumLines *
+                          ObjectMacroCorpus::ExpansionsPerLine);
+}
+BENCHMARK(BM_ObjectMacros)->ArgName("cached")->Arg(0)->Arg(1);
+
+}  // namespace
+
+BENCHMARK_MAIN();
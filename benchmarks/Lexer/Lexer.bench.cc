@@ -0,0 +1,396 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "llvm/Support/MemoryBuffer.h"
+#include "tinyclang/Basic/FileManager.h"
+#include "tinyclang/Diagnostic/Diagnostic.h"
+#include "tinyclang/Lexer/Lexer.h"
+#include "tinyclang/Lexer/Preprocessor.h"
+#include "tinyclang/Source/SourceManager.h"
+
+// Lexer throughput, in MB/s and tokens/s, over a few kinds of input:
+//
+//   BM_RawLex      - Lexer::Lex called directly, with no Preprocessor::Lex in
+//                    between, over a file with no directives.
+//   BM_Lex         - Preprocessor::Lex over a file with no directives and no
+//                    macros, so every token comes straight from Lexer::Lex.
+//   BM_LexMacros   - The same, with the code full of object-like macros.
+//   BM_PrintE      - -E mode: lex, then print each token with its spacing.
+//   BM_LexSkipped  - A file that is nothing but an #if 0 block.
+//
+// Each runs over a generated corpus and over real headers: the fixed set in
+// benchmarks/Lexer/Inputs, or the ones in $TINYCLANG_BENCH_HEADERS if set.  The
+// headers are read in sorted order, and each result records the size and a
+// hash of its corpus in the corpus_bytes and corpus_hash counters: only compare
+// results where those match.  For tracking regressions, keep the results as
+// JSON:
+//
+//   Lexer.bench --benchmark_out=lexer.json --benchmark_out_format=json
+
+namespace {
+
+class IgnoreDiagnostics : public tinyclang::DiagnosticClient {
+ public:
+  void HandleDiagnostic(tinyclang::Diagnostic::Level, tinyclang::SourceLocation,
+                        tinyclang::diag::kind, const std::string&) override {}
+};
+
+enum CorpusKind { Generated, Headers };
+
+/// makeGeneratedCode - Return about 'size' bytes of made-up C: declarations,
+/// statements full of operators, literals of every kind and both kinds of
+/// comment.  When 'num_macros' is nonzero, the code is preceded by that many
+/// object-like macros, some defined in terms of others, and about a third of
+/// the identifiers in it name one of them.
+auto makeGeneratedCode(unsigned size, unsigned num_macros) -> std::string {
+  std::mt19937 rng(42);
+  auto pick = [&](unsigned n) { return unsigned(rng() % n); };
+
+  static const char* const words[] = {
+      "i",      "n",      "len",     "count",   "buffer",   "result",
+      "state",  "ptr",    "next",    "value",   "context",  "handler",
+      "size_t", "uint8_t", "flags",  "options", "callback", "Identifier"};
+  static const char* const types[] = {"int",  "unsigned", "char",
+                                      "long", "double",   "struct node"};
+  static const char* const ops[] = {"+",  "-",  "*",  "/",  "%",  "<<", ">>",
+                                    "&",  "|",  "^",  "&&", "||", "==", "!=",
+                                    "<=", ">=", "<",  ">",  "->", "."};
+  static const char* const literals[] = {
+      "0",          "1",     "42",       "0x7fffffff", "1.25",
+      "6.02e23",    "10UL",  "'a'",      "'\\n'",      "\"hello, world\\n\"",
+      "\"%s: %d\"", "0.5f",  "0777",     "L\"wide\"",  "\"\""};
+
+  std::string text;
+  auto ident = [&] {
+    if (num_macros && pick(3) == 0) {
+      return "MACRO_" + std::to_string(pick(num_macros));
+    }
+    return std::string(words[pick(std::size(words))]);
+  };
+  auto operand = [&] {
+    return pick(2) ? ident() : std::string(literals[pick(std::size(literals))]);
+  };
+
+  for (unsigned i = 0; i != num_macros; ++i) {
+    text += "#define MACRO_" + std::to_string(i) + " ";
+    text += i && pick(2) ? "(MACRO_" + std::to_string(pick(i)) + " + 1)"
+                         : std::string(literals[pick(std::size(literals))]);
+    text += '\n';
+  }
+
+  while (text.size() < size) {
+    text += "/* " + ident() + " of the " + ident() + ". */\n";
+    text += std::string(types[pick(std::size(types))]) + " " + ident() + "(";
+    text += std::string(types[pick(std::size(types))]) + " " + ident() + ", ";
+    text += std::string(types[pick(std::size(types))]) + " *" + ident() +
+            ") {\n";
+    for (unsigned stmt = 0, e = 2 + pick(8); stmt != e; ++stmt) {
+      text += "  ";
+      switch (pick(4)) {
+        case 0:
+          text += "if (" + operand() + " " + ops[pick(std::size(ops))] + " " +
+                  operand() + ")\n    ";
+          break;
+        case 1:
+          text += "// " + ident() + " " + ident() + "\n  ";
+          break;
+      }
+      text += ident() + " = " + operand();
+      for (unsigned term = 0, n = pick(4); term != n; ++term) {
+        text += " ";
+        text += ops[pick(std::size(ops))];
+        text += " " + operand();
+      }
+      text += ";\n";
+    }
+    text += "  return " + operand() + ";\n}\n\n";
+  }
+  return text;
+}
+
+/// readHeaders - Return the headers pasted together, in the order of their
+/// names, until they are at least 'size' bytes.  These are the headers in
+/// $TINYCLANG_BENCH_HEADERS if set, and otherwise the ones in
+/// benchmarks/Lexer/Inputs.
+auto readHeaders(unsigned size) -> std::string {
+  const char* dir = std::getenv("TINYCLANG_BENCH_HEADERS");
+  std::vector<std::filesystem::path> paths;
+  std::error_code ec;
+  for (const auto& entry :
+       std::filesystem::directory_iterator(dir ? dir : TINYCLANG_BENCH_INPUTS,
+                                           ec)) {
+    if (entry.path().extension() == ".h") {
+      paths.push_back(entry.path());
+    }
+  }
+  std::sort(paths.begin(), paths.end());
+
+  std::vector<std::string> headers;
+  for (const std::filesystem::path& path : paths) {
+    std::ifstream in(path, std::ios::binary);
+    headers.emplace_back(std::istreambuf_iterator<char>(in),
+                         std::istreambuf_iterator<char>());
+  }
+  if (headers.empty()) {
+    headers.push_back("extern int some_declaration(const char *, ...);\n");
+  }
+
+  std::string text;
+  while (text.size() < size) {
+    for (const std::string& header : headers) {
+      text += header;
+    }
+  }
+  return text;
+}
+
+/// stripDirectives - Blank out every directive line, and the lines it is
+/// continued onto, so that no #include is looked up and no #if is evaluated.
+auto stripDirectives(const std::string& text) -> std::string {
+  std::string result;
+  result.reserve(text.size());
+  bool in_directive = false;
+  size_t pos = 0;
+  while (pos < text.size()) {
+    size_t eol = text.find('\n', pos);
+    if (eol == std::string::npos) {
+      eol = text.size();
+    }
+    size_t first = text.find_first_not_of(" \t", pos);
+    if (!in_directive && first < eol && text[first] == '#') {
+      in_directive = true;
+    }
+    if (in_directive) {
+      in_directive = eol != pos && text[eol - 1] == '\\';
+    } else {
+      result.append(text, pos, eol - pos);
+    }
+    result += '\n';
+    pos = eol + 1;
+  }
+  return result;
+}
+
+/// hashText - Return the 32-bit FNV-1a hash of 'text', which is exact as a
+/// benchmark counter.
+auto hashText(const std::string& text) -> uint32_t {
+  uint32_t hash = 2166136261u;
+  for (char c : text) {
+    hash = (hash ^ (unsigned char)c) * 16777619u;
+  }
+  return hash;
+}
+
+/// Corpus - The text one benchmark lexes, how many tokens it yields, and its
+/// hash.
+struct Corpus {
+  enum { CorpusSize = 4 << 20, NumMacros = 512 };
+
+  std::string Text;
+  unsigned NumTokens = 0;
+  uint32_t Hash = 0;
+};
+
+/// BenchPreprocessor - A Preprocessor with nothing in it but one buffer, which
+/// it is lexing from unless 'enter' is false.
+struct BenchPreprocessor {
+  IgnoreDiagnostics DiagClient;
+  tinyclang::Diagnostic Diags;
+  tinyclang::LangOptions LangOpts;
+  tinyclang::FileManager FileMgr;
+  tinyclang::SourceManager SourceMgr;
+  tinyclang::Preprocessor PP;
+  unsigned FileID;
+
+  explicit BenchPreprocessor(const std::string& text, bool enter = true)
+      : Diags(DiagClient),
+        LangOpts(getLangOptions()),
+        PP(Diags, LangOpts, FileMgr, SourceMgr),
+        FileID(SourceMgr.createFileIDForMemBuffer(
+            llvm::MemoryBuffer::getMemBuffer(text).release())) {
+    if (enter) {
+      PP.EnterSourceFile(FileID, 0);
+    }
+  }
+
+  /// getLangOptions - The options the driver turns on.
+  static auto getLangOptions() -> tinyclang::LangOptions {
+    tinyclang::LangOptions lang_opts;
+    lang_opts.Trigraphs = 1;
+    lang_opts.BCPLComment = 1;
+    lang_opts.C99 = 1;
+    lang_opts.DollarIdents = lang_opts.Digraphs = 1;
+    lang_opts.ObjC1 = lang_opts.ObjC2 = 1;
+    return lang_opts;
+  }
+};
+
+/// lexAll - Lex the buffer 'pp' was set up with, returning the token count.
+auto lexAll(tinyclang::Preprocessor& pp) -> unsigned {
+  unsigned num_tokens = 0;
+  tinyclang::LexerToken tok;
+  do {
+    pp.Lex(tok);
+    ++num_tokens;
+  } while (tok.getKind() != tinyclang::tok::eof);
+  return num_tokens;
+}
+
+auto makeCorpus(CorpusKind kind, unsigned num_macros, bool skipped)
+    -> Corpus {
+  Corpus corpus;
+  if (kind == Generated) {
+    corpus.Text = makeGeneratedCode(Corpus::CorpusSize, num_macros);
+  } else if (skipped) {
+    corpus.Text = readHeaders(Corpus::CorpusSize);
+  } else {
+    corpus.Text = stripDirectives(readHeaders(Corpus::CorpusSize));
+  }
+  if (skipped) {
+    corpus.Text = "#if 0\n" + corpus.Text + "\n#endif\n";
+  }
+  BenchPreprocessor bench_pp(corpus.Text);
+  corpus.NumTokens = lexAll(bench_pp.PP);
+  corpus.Hash = hashText(corpus.Text);
+  return corpus;
+}
+
+auto getPlainCorpus(CorpusKind kind) -> const Corpus& {
+  static Corpus generated = makeCorpus(Generated, 0, false);
+  static Corpus headers = makeCorpus(Headers, 0, false);
+  return kind == Generated ? generated : headers;
+}
+
+auto getMacroCorpus() -> const Corpus& {
+  static Corpus corpus = makeCorpus(Generated, Corpus::NumMacros, false);
+  return corpus;
+}
+
+auto getSkippedCorpus(CorpusKind kind) -> const Corpus& {
+  static Corpus generated = makeCorpus(Generated, 0, true);
+  static Corpus headers = makeCorpus(Headers, 0, true);
+  return kind == Generated ? generated : headers;
+}
+
+void setCounters(benchmark::State& state, const Corpus& corpus) {
+  state.SetBytesProcessed(state.iterations() * corpus.Text.size());
+  state.counters["tokens/s"] = benchmark::Counter(
+      corpus.NumTokens, benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["corpus_bytes"] = corpus.Text.size();
+  state.counters["corpus_hash"] = corpus.Hash;
+}
+
+/// runLexBenchmark - Time lexing all of 'corpus' with a fresh Preprocessor for
+/// each iteration.
+void runLexBenchmark(benchmark::State& state, const Corpus& corpus) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    {
+      BenchPreprocessor bench_pp(corpus.Text);
+      state.ResumeTiming();
+      benchmark::DoNotOptimize(lexAll(bench_pp.PP));
+      state.PauseTiming();
+    }
+    state.ResumeTiming();
+  }
+  setCounters(state, corpus);
+}
+
+/// BM_RawLex - Lex the corpus BM_Lex does with a Lexer of its own, which the
+/// Preprocessor only looks up identifiers for.  It stops short of the tok::eof,
+/// which the Lexer would hand to the Preprocessor to pop it.
+void BM_RawLex(benchmark::State& state) {
+  const Corpus& corpus = getPlainCorpus(CorpusKind(state.range(0)));
+  for (auto _ : state) {
+    state.PauseTiming();
+    {
+      BenchPreprocessor bench_pp(corpus.Text, /*enter=*/false);
+      tinyclang::Lexer lexer(
+          bench_pp.SourceMgr.getBuffer(bench_pp.FileID), bench_pp.FileID,
+          bench_pp.PP);
+      state.ResumeTiming();
+
+      tinyclang::LexerToken tok;
+      for (unsigned i = 1; i != corpus.NumTokens; ++i) {
+        lexer.Lex(tok);
+      }
+      benchmark::DoNotOptimize(tok);
+
+      state.PauseTiming();
+    }
+    state.ResumeTiming();
+  }
+  setCounters(state, corpus);
+}
+BENCHMARK(BM_RawLex)->ArgName("headers")->Arg(Generated)->Arg(Headers);
+
+void BM_Lex(benchmark::State& state) {
+  runLexBenchmark(state, getPlainCorpus(CorpusKind(state.range(0))));
+}
+BENCHMARK(BM_Lex)->ArgName("headers")->Arg(Generated)->Arg(Headers);
+
+void BM_LexMacros(benchmark::State& state) {
+  runLexBenchmark(state, getMacroCorpus());
+}
+BENCHMARK(BM_LexMacros);
+
+void BM_LexSkipped(benchmark::State& state) {
+  runLexBenchmark(state, getSkippedCorpus(CorpusKind(state.range(0))));
+}
+BENCHMARK(BM_LexSkipped)->ArgName("headers")->Arg(Generated)->Arg(Headers);
+
+/// BM_PrintE - What the driver's -E mode does, with the output going to a
+/// string instead of stdout.
+void BM_PrintE(benchmark::State& state) {
+  const Corpus& corpus = getPlainCorpus(CorpusKind(state.range(0)));
+  std::string output;
+  for (auto _ : state) {
+    state.PauseTiming();
+    {
+      BenchPreprocessor bench_pp(corpus.Text);
+      tinyclang::Preprocessor& pp = bench_pp.PP;
+      output.clear();
+      state.ResumeTiming();
+
+      tinyclang::LexerToken tok;
+      char buffer[256];
+      do {
+        pp.Lex(tok);
+        if (tok.isAtStartOfLine()) {
+          output += '\n';
+          unsigned col_no =
+              pp.getSourceManager().getColumnNumber(tok.getSourceLocation());
+          if (col_no > 1) {
+            output.append(col_no - 1, ' ');
+          }
+        } else if (tok.hasLeadingSpace()) {
+          output += ' ';
+        }
+        if (tok.getLength() < sizeof(buffer)) {
+          output.append(buffer, pp.getSpelling(tok, buffer));
+        } else {
+          output += pp.getSpelling(tok);
+        }
+      } while (tok.getKind() != tinyclang::tok::eof);
+      benchmark::DoNotOptimize(output.data());
+
+      state.PauseTiming();
+    }
+    state.ResumeTiming();
+  }
+  setCounters(state, corpus);
+}
+BENCHMARK(BM_PrintE)->ArgName("headers")->Arg(Generated)->Arg(Headers);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,145 @@
+#include "tinyclang/Source/LineScanner.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "llvm/Support/MemoryBuffer.h"
+#include "tinyclang/Source/SourceManager.h"
+
+namespace {
+
+/// Corpus - A multi-megabyte preprocessed-output-like buffer.  This is the file
+/// named by $TINYCLANG_BENCH_I_FILE if set (e.g. a real .i file), and otherwise
+/// the system headers pasted together in sorted order until it is CorpusSize
+/// bytes, which looks a lot like a .i file.  A \r\n copy is kept too, since
+/// pairs take a different path through the scanners.
+struct Corpus {
+  enum { CorpusSize = 8 << 20 };
+
+  std::unique_ptr<llvm::MemoryBuffer> LF, CRLF;
+
+  Corpus() {
+    std::string text;
+    if (const char* path = std::getenv("TINYCLANG_BENCH_I_FILE")) {
+      std::ifstream in(path, std::ios::binary);
+      text.assign(std::istreambuf_iterator<char>(in),
+                  std::istreambuf_iterator<char>());
+    } else {
+      std::vector<std::filesystem::path> paths;
+      std::error_code ec;
+      for (const auto& entry :
+           std::filesystem::directory_iterator("/usr/include", ec)) {
+        if (entry.path().extension() == ".h") {
+          paths.push_back(entry.path());
+        }
+      }
+      std::sort(paths.begin(), paths.end());
+
+      std::vector<std::string> headers;
+      for (const std::filesystem::path& path : paths) {
+        std::ifstream in(path, std::ios::binary);
+        headers.emplace_back(std::istreambuf_iterator<char>(in),
+                             std::istreambuf_iterator<char>());
+      }
+      if (headers.empty()) {
+        headers.push_back("extern int some_declaration(const char *, ...);\n");
+      }
+      while (text.size() < CorpusSize) {
+        for (const std::string& header : headers) {
+          text += header;
+        }
+      }
+    }
+
+    std::string crlf;
+    crlf.reserve(text.size() + text.size() / 16);
+    for (char c : text) {
+      if (c == '\n') {
+        crlf += '\r';
+      }
+      crlf += c;
+    }
+
+    LF = llvm::MemoryBuffer::getMemBufferCopy(text, "bench.i");
+    CRLF = llvm::MemoryBuffer::getMemBufferCopy(crlf, "bench-crlf.i");
+  }
+
+  const llvm::MemoryBuffer& get(bool crlf) const { return crlf ? *CRLF : *LF; }
+};
+
+auto getCorpus() -> const Corpus& {
+  static Corpus corpus;
+  return corpus;
+}
+
+auto scan(const llvm::MemoryBuffer& buffer, tinyclang::LineScanKind kind)
+    -> std::vector<unsigned> {
+  std::vector<unsigned> offsets;
+  tinyclang::computeLineOffsets(buffer.getBufferStart(), buffer.getBufferEnd(),
+                                offsets, kind);
+  return offsets;
+}
+
+/// BM_LineTable - Build the line table of the corpus with one scanner.  Before
+/// timing, check it agrees with the scalar scanner on the corpus; the corner
+/// cases are covered by unittests/Source/LineScanner.t.cc.
+template <tinyclang::LineScanKind Kind>
+void BM_LineTable(benchmark::State& state) {
+  if (!tinyclang::isLineScanKindSupported(Kind)) {
+    state.SkipWithError("not supported by this CPU");
+    return;
+  }
+
+  const llvm::MemoryBuffer& buffer = getCorpus().get(state.range(0));
+  if (scan(buffer, Kind) != scan(buffer, tinyclang::LineScanKind::Scalar)) {
+    state.SkipWithError("line table differs from the scalar scanner");
+    return;
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(scan(buffer, Kind));
+  }
+  state.SetBytesProcessed(state.iterations() * buffer.getBufferSize());
+}
+BENCHMARK_TEMPLATE(BM_LineTable, tinyclang::LineScanKind::Scalar)
+    ->ArgName("crlf")
+    ->Arg(0)
+    ->Arg(1);
+BENCHMARK_TEMPLATE(BM_LineTable, tinyclang::LineScanKind::SSE2)
+    ->ArgName("crlf")
+    ->Arg(0)
+    ->Arg(1);
+BENCHMARK_TEMPLATE(BM_LineTable, tinyclang::LineScanKind::AVX2)
+    ->ArgName("crlf")
+    ->Arg(0)
+    ->Arg(1);
+
+/// BM_SourceManagerFirstLineNumber - The first getLineNumber call on a freshly
+/// loaded buffer, which is what a diagnostic in a new file pays.
+void BM_SourceManagerFirstLineNumber(benchmark::State& state) {
+  const llvm::MemoryBuffer& buffer = getCorpus().get(false);
+  for (auto _ : state) {
+    state.PauseTiming();
+    tinyclang::SourceManager source_mgr;
+    unsigned file_id = source_mgr.createFileIDForMemBuffer(
+        llvm::MemoryBuffer::getMemBuffer(buffer.getBuffer(), "", true)
+            .release());
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(
+        source_mgr.getLineNumber(source_mgr.getLocForStartOfFile(file_id)));
+  }
+  state.SetBytesProcessed(state.iterations() * buffer.getBufferSize());
+}
+BENCHMARK(BM_SourceManagerFirstLineNumber);
+
+}  // namespace
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -1,10 +1,14 @@
 #ifndef TINYCLANG_BASIC_FILEMANAGER_H
 #define TINYCLANG_BASIC_FILEMANAGER_H
 
-#include <map>
 #include <string>
 #include <sys/types.h>
 
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Support/Allocator.h"
+
 namespace tinyclang {
 
 class FileManager;
@@ -12,7 +16,14 @@ class FileManager;
 /// DirectoryEntry - Cached information about one directory on the disk.
 class DirectoryEntry {
   std::string Name;  // Name of the directory.
-  DirectoryEntry() {}
+
+  /// Contents - The names of the entries in this directory.  This is only read
+  /// (with a single readdir pass) when the FileManager is caching directory
+  /// listings, and only valid if ContentsState is ContentsRead.
+  llvm::StringSet<> Contents;
+  enum { ContentsNotRead, ContentsRead, ContentsUnavailable } ContentsState;
+
+  DirectoryEntry() : ContentsState(ContentsNotRead) {}
   friend class FileManager;
 
  public:
@@ -46,36 +57,68 @@ class FileEntry {
 /// names (e.g. symlinked) will be treated as a single file.
 class FileManager {
   /// DirEntries/FileEntries - This is a cache of directory/file entries we have
-  /// looked up.
-  std::map<std::string, DirectoryEntry*> DirEntries;
-  std::map<std::string, FileEntry*> FileEntries;
+  /// looked up.  These are probed for every #include in every search directory,
+  /// so they are hashed, and the path strings are interned in a bump allocator
+  /// owned by the map.  A null value records a path known not to exist.
+  llvm::StringMap<DirectoryEntry*, llvm::BumpPtrAllocator> DirEntries;
+  llvm::StringMap<FileEntry*, llvm::BumpPtrAllocator> FileEntries;
 
   /// UniqueDirs/UniqueFiles - Cache from ID's to existing directories/files.
-  std::map<std::pair<dev_t, ino_t>, DirectoryEntry*> UniqueDirs;
-  std::map<std::pair<dev_t, ino_t>, FileEntry*> UniqueFiles;
+  llvm::DenseMap<std::pair<dev_t, ino_t>, DirectoryEntry*> UniqueDirs;
+  llvm::DenseMap<std::pair<dev_t, ino_t>, FileEntry*> UniqueFiles;
+
+  /// DirEntryAlloc/FileEntryAlloc - The entries are never freed individually,
+  /// only all together when the FileManager dies, so carve them out of slabs
+  /// instead of doing a malloc per entry.
+  llvm::SpecificBumpPtrAllocator<DirectoryEntry> DirEntryAlloc;
+  llvm::SpecificBumpPtrAllocator<FileEntry> FileEntryAlloc;
 
   /// NextFileUID - Each FileEntry we create is assigned a unique ID #.
   unsigned NextFileUID;
 
+  /// CacheDirListings - If true, the contents of a directory are read once and
+  /// used to answer lookups of names that aren't in it without a stat call.
+  /// Files created in a directory after it was read will not be found.
+  bool CacheDirListings;
+
   // Statistics.
   unsigned NumDirLookups, NumFileLookups;
   unsigned NumDirCacheMisses, NumFileCacheMisses;
+  unsigned NumDirListingsRead, NumStatsAvoided;
 
  public:
-  FileManager() : NextFileUID(0) {
+  FileManager() : NextFileUID(0), CacheDirListings(false) {
     NumDirLookups = NumFileLookups = 0;
     NumDirCacheMisses = NumFileCacheMisses = 0;
+    NumDirListingsRead = NumStatsAvoided = 0;
   }
 
+  /// setCacheDirectoryListings - When set to true, failing lookups in a known
+  /// directory are answered from a cached listing of that directory instead
+  /// of a stat call.  This is a big win with many #include search paths.
+  void setCacheDirectoryListings(bool Val) { CacheDirListings = Val; }
+  bool getCacheDirectoryListings() const { return CacheDirListings; }
+
   /// getDirectory - Lookup, cache, and verify the specified directory.  This
   /// returns null if the directory doesn't exist.
-  auto getDirectory(const std::string& filename) -> const DirectoryEntry*;
+  auto getDirectory(llvm::StringRef filename) -> const DirectoryEntry* {
+    return getDirectoryEntry(filename);
+  }
 
   /// getFile - Lookup, cache, and verify the specified file.  This returns null
   /// if the file doesn't exist.
-  auto getFile(const std::string& filename) -> const FileEntry*;
+  auto getFile(llvm::StringRef filename) -> const FileEntry*;
 
   void PrintStats() const;
+
+ private:
+  auto getDirectoryEntry(llvm::StringRef filename) -> DirectoryEntry*;
+
+  /// isMissingFromDirectory - Return true if the listing of the specified
+  /// directory is available and doesn't contain name.  The listing is read on
+  /// first use.
+  auto isMissingFromDirectory(DirectoryEntry& dir, llvm::StringRef name)
+      -> bool;
 };
 
 }  // namespace tinyclang
@@ -9,6 +9,7 @@ namespace tinyclang {
 
 class IdentifierTable;
 class MacroInfo;
+struct LangOptions;
 
 /// IdentifierTokenInfo - One of these records is kept for each identifier that
 /// is lexed.  This contains information about whether the token was #define'd,
@@ -19,6 +20,8 @@ class IdentifierTokenInfo {
   unsigned NameLen;            // String that is the identifier.
   MacroInfo* Macro;            // Set if this identifier is #define'd.
   tok::TokenKind TokenID : 8;  // Nonzero if this is a front-end token.
+  // PPKeywordID - The directive this names, e.g. pp_define for "define".
+  tok::PPKeywordKind PPKeywordID : 8;
   bool IsExtension : 1;        // True if this token is a language extension.
   void* FETokenInfo;           // Managed by the language front-end.
   friend class IdentifierTable;
@@ -48,6 +51,10 @@ class IdentifierTokenInfo {
   tok::TokenKind getTokenID() const { return TokenID; }
   void setTokenID(tok::TokenKind id) { TokenID = id; }
 
+  /// getPPKeywordID - Return the preprocessor directive this identifier names,
+  /// or tok::pp_not_keyword.
+  tok::PPKeywordKind getPPKeywordID() const { return PPKeywordID; }
+
   /// get/setExtension - Initialize information about whether or not this
   /// language token is an extension.  This controls extension warnings, and is
   /// only valid if a custom token ID is set.
@@ -61,31 +68,81 @@ class IdentifierTokenInfo {
     return static_cast<T*>(FETokenInfo);
   }
   void setFETokenInfo(void* t) { FETokenInfo = t; }
-
- private:
-  void Destroy();
 };
 
 /// IdentifierTable - This table implements an efficient mapping from strings to
 /// IdentifierTokenInfo nodes.  It has no other purpose, but this is an
 /// extremely performance-critical piece of the code, as each occurrance of
 /// every identifier goes through here when lexed.
+///
+/// Keywords and directive names are recognized when their identifier is first
+/// created, by a perfect hash built at compile time from TokenKind.def, so
+/// there is nothing to register up front.
 class IdentifierTable {
   void* TheTable;
   void* TheMemory;
+  unsigned TableSize;  // Number of slots in TheTable, a power of two.
   unsigned NumIdentifiers;
+  unsigned NumGrows;
+
+  /// KeywordLangShift/NoExtensions - Which language's keyword flags apply, and
+  /// whether extension keywords are disabled.
+  unsigned KeywordLangShift;
+  bool NoExtensions;
 
  public:
-  IdentifierTable();
+  /// IdentifierTable ctor - Create the table for the keywords of the specified
+  /// language.
+  explicit IdentifierTable(const LangOptions& LangOpts);
   ~IdentifierTable();
   /// get - Return the identifier token info for the specified named identifier.
   ///
-  IdentifierTokenInfo& get(const char* NameStart, const char* NameEnd);
+  IdentifierTokenInfo& get(const char* NameStart, const char* NameEnd) {
+    return get(NameStart, NameEnd, HashString(NameStart, NameEnd));
+  }
   IdentifierTokenInfo& get(const std::string& Name);
 
+  /// get - This version takes the HashString of the identifier, for callers
+  /// that computed it already, like the lexer.
+  IdentifierTokenInfo& get(const char* NameStart, const char* NameEnd,
+                           unsigned FullHash);
+
+  /// HashString - Compute the hash code of the specified identifier.  This is
+  /// HashChar folded over the characters, then HashFinish.  Each step is just
+  /// a shift and two adds, which is hard to beat for identifiers a dozen
+  /// characters long; the mixing that makes the low bits usable for indexing
+  /// a power-of-two table is done once, at the end.
+  static constexpr unsigned HashString(const char* Start, const char* End) {
+    unsigned Hash = 0;
+    while (Start != End)
+      Hash = HashChar(Hash, *Start++);
+    return HashFinish(Hash);
+  }
+  static constexpr unsigned HashChar(unsigned Hash, char C) {
+    return Hash * 33 + (unsigned char)C;
+  }
+  static constexpr unsigned HashFinish(unsigned Hash) {
+    // The MurmurHash3 finalizer: every input bit affects every output bit.
+    Hash ^= Hash >> 16;
+    Hash *= 0x85ebca6b;
+    Hash ^= Hash >> 13;
+    Hash *= 0xc2b2ae35;
+    Hash ^= Hash >> 16;
+    return Hash;
+  }
+
+  /// getPPKeywordID - Return the preprocessor directive the specified name
+  /// spells, if any.  This doesn't create an identifier, so it works while
+  /// identifiers aren't being looked up, e.g. in a skipped #if block.
+  static tok::PPKeywordKind getPPKeywordID(const char* NameStart,
+                                           const char* NameEnd);
+
   /// PrintStats - Print some statistics to stderr that indicate how well the
   /// hashing is doing.
   void PrintStats() const;
+
+ private:
+  void Grow();
 };
 
 }  // namespace tinyclang
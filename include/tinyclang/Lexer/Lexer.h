@@ -2,19 +2,23 @@
 #define TINYCLANG_LEXER_LEXER_H
 
 #include <cassert>
+#include <cstdint>
 #include <string>
 #include <vector>
 
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "tinyclang/Lexer/MultipleIncludeOpt.h"
 #include "tinyclang/Lexer/TokenKind.h"
+#include "tinyclang/Source/SourceLocation.h"
 
 namespace tinyclang {
 
 class Diagnostic;
 class Lexer;
 class Preprocessor;
-class SourceLocation;
 class IdentifierTokenInfo;
+class SourceManager;
 
 struct LangOptions {
   unsigned Trigraphs : 1;     // Trigraphs in source files.
@@ -37,20 +41,23 @@ struct LangOptions {
 };
 
 /// LexerToken - This structure provides full information about a lexed token.
-/// it is not intended to be space efficient, it is intended to return as much
-/// information as possible about each returned token.  This is expected to be
-/// compressed into a smaller form if memory footprint is important.
+/// It is kept to 16 bytes, since tokens are copied around a lot and stored in
+/// macro bodies: the characters of the token are found through its location,
+/// see Lexer::getSpelling, and the identifier pointer shares a word with the
+/// kind and flags.
 class LexerToken {
-  /// The start and end of the token text itself.
-  const char* Start;
-  unsigned Length;
+  /// Loc - The location of the token.  For a token produced by a macro
+  /// expansion this is a macro location, see SourceManager.
+  SourceLocation Loc;
 
-  /// TheLexer - The lexer object this token came from.
-  const Lexer* TheLexer;
+  /// Length - The number of characters the token spans in the source, before
+  /// trigraphs and escaped newlines are folded.
+  unsigned Length;
 
   /// IdentifierInfo - If this was an identifier, this points to the uniqued
-  /// information about this identifier.
-  IdentifierTokenInfo* IdentifierInfo;
+  /// information about this identifier.  Heap addresses fit in 48 bits on all
+  /// the 64-bit targets we run on, which leaves room for the fields below.
+  uintptr_t IdentifierInfo : 48;
 
   /// Kind - The actual flavor of token this is.
   ///
@@ -64,36 +71,33 @@ class LexerToken {
   enum TokenFlags {
     StartOfLine = 0x01,   // At start of line or only after whitespace.
     LeadingSpace = 0x02,  // Whitespace exists before this token.
-    NeedsCleaning = 0x04  // Contained an escaped newline or trigraph.
-    // #define STRINGIFY_ARG   (1 << 2) /* If macro argument to be stringified.
-    // #define PASTE_LEFT      (1 << 3) /* If on LHS of a ## operator.
+    NeedsCleaning = 0x04,  // Contained an escaped newline or trigraph.
+    DisableExpand = 0x08   // This identifier may never be macro expanded.
   };
 
   tok::TokenKind getKind() const { return Kind; }
   void SetKind(tok::TokenKind K) { Kind = K; }
 
-  const char* getStart() const { return Start; }
-  const char* getEnd() const { return Start + Length; }
   unsigned getLength() const { return Length; }
-  void SetStart(const char* S) { Start = S; }
-
-  /// SetEnd - Specify the length of the token as lexed.  This relies on the
-  /// start of the token having already been set.
-  void SetEnd(const char* End) { Length = End - Start; }
+  void SetLength(unsigned Len) { Length = Len; }
 
   /// ClearFlags - Reset all flags to cleared.
   ///
-  void StartToken(const Lexer* L) {
+  void StartToken() {
     Flags = 0;
     IdentifierInfo = 0;
-    TheLexer = L;
   }
 
-  /// ClearPosition - Mark this token as not having a position, FIXME temporary.
-  void ClearPosition() { TheLexer = 0; }
+  /// SetLocation - Set the location of the token.
+  void SetLocation(SourceLocation L) { Loc = L; }
 
-  IdentifierTokenInfo* getIdentifierInfo() const { return IdentifierInfo; }
-  void SetIdentifierInfo(IdentifierTokenInfo* II) { IdentifierInfo = II; }
+  IdentifierTokenInfo* getIdentifierInfo() const {
+    return reinterpret_cast<IdentifierTokenInfo*>(IdentifierInfo);
+  }
+  void SetIdentifierInfo(IdentifierTokenInfo* II) {
+    IdentifierInfo = reinterpret_cast<uintptr_t>(II);
+    assert(getIdentifierInfo() == II && "Pointer doesn't fit in 48 bits!");
+  }
 
   /// SetFlag - Set the specified flag.
   void SetFlag(TokenFlags Flag) { Flags |= Flag; }
@@ -109,9 +113,8 @@ class LexerToken {
       ClearFlag(Flag);
   }
 
-  /// getSourceLocation - Return a source location identifier for the specified
-  /// offset in the current file.
-  SourceLocation getSourceLocation() const;
+  /// getSourceLocation - Return the location of this token.
+  SourceLocation getSourceLocation() const { return Loc; }
 
   /// isAtStartOfLine - Return true if this token is at the start of a line.
   ///
@@ -126,16 +129,24 @@ class LexerToken {
   ///
   bool needsCleaning() const { return Flags & NeedsCleaning; }
 
+  /// isExpandDisabled - Return true if this identifier named a macro that was
+  /// being expanded when it was read, so it is never expanded (C99 6.10.3.4p2).
+  ///
+  bool isExpandDisabled() const { return Flags & DisableExpand; }
+
   /// dump - Print the token to stderr, used for debugging.
   ///
-  void dump(const LangOptions& Features, bool DumpFlags = false) const;
+  void dump(const SourceManager& SourceMgr, const LangOptions& Features,
+            bool DumpFlags = false) const;
 };
 
+static_assert(sizeof(LexerToken) == 16, "LexerToken should be 16 bytes");
+
 /// PPConditionalInfo - Information about the conditional stack (#if directives)
 /// currently active.
 struct PPConditionalInfo {
   /// IfLoc - Location where the conditional started.
-  const char* IfLoc;
+  SourceLocation IfLoc;
 
   /// WasSkipping - True if this was contained in a skipping directive, e.g.
   /// in a "#if 0" block.
@@ -161,6 +172,7 @@ class Lexer {
   const char* const BufferEnd;    // End of the buffer.
   const llvm::MemoryBuffer* InputFile;  // The file we are reading from.
   unsigned CurFileID;             // FileID for the current input file.
+  SourceLocation FileLoc;         // Location of BufferStart.
   Preprocessor& PP;               // Preprocessor object controlling lexing.
   LangOptions Features;           // Features enabled by this language (cache).
 
@@ -172,8 +184,13 @@ class Lexer {
   // Context that changes as the file is lexed.
 
   /// ConditionalStack - Information about the set of #if/#ifdef/#ifndef blocks
-  /// we are currently in.
-  std::vector<PPConditionalInfo> ConditionalStack;
+  /// we are currently in.  Headers rarely nest them deeply, so entering one
+  /// doesn't touch the heap.
+  llvm::SmallVector<PPConditionalInfo, 8> ConditionalStack;
+
+  /// MIOpt - This is a state machine that detects the #ifndef-wrapping a file
+  /// idiom for the multiple-include optimization.
+  MultipleIncludeOpt MIOpt;
 
   friend class Preprocessor;
 
@@ -199,7 +216,7 @@ class Lexer {
   /// the preprocessor.
   void Lex(LexerToken& Result) {
     // Start a new token.
-    Result.StartToken(this);
+    Result.StartToken();
 
     // NOTE, any changes here should also change code after calls to
     // Preprocessor::HandleDirective
@@ -220,23 +237,25 @@ class Lexer {
   /// token is the characters used to represent the token in the source file
   /// after trigraph expansion and escaped-newline folding.  In particular, this
   /// wants to get the true, uncanonicalized, spelling of things like digraphs
-  /// UCNs, etc.
+  /// UCNs, etc.  The characters are found through the token's location.
   static std::string getSpelling(const LexerToken& Tok,
+                                 const SourceManager& SourceMgr,
                                  const LangOptions& Features);
   std::string getSpelling(const LexerToken& Tok) const {
-    assert(this && "Can't get the spelling of a token with a null lexer!");
-    return getSpelling(Tok, Features);
+    return getSpelling(Tok, getBufferLocation(Tok.getSourceLocation()),
+                       Features);
   }
 
   /// getSpelling - This method is used to get the spelling of a token into a
   /// preallocated buffer, instead of as an std::string.  The caller is required
   /// to allocate enough space for the token, which is guaranteed to be at most
-  /// Tok.End-Tok.Start bytes long.  The actual length of the token is returned.
+  /// Tok.getLength() bytes long.  The actual length of the token is returned.
   static unsigned getSpelling(const LexerToken& Tok, char* Buffer,
+                              const SourceManager& SourceMgr,
                               const LangOptions& Features);
   unsigned getSpelling(const LexerToken& Tok, char* Buffer) const {
-    assert(this && "Can't get the spelling of a token with a null lexer!");
-    return getSpelling(Tok, Buffer, Features);
+    return getSpelling(Tok, getBufferLocation(Tok.getSourceLocation()), Buffer,
+                       Features);
   }
 
   /// Diag - Forwarding function for diagnostics.  This translate a source
@@ -248,6 +267,14 @@ class Lexer {
   /// offset in the current file.
   SourceLocation getSourceLocation(const char* Loc) const;
 
+  /// getBufferLocation - Return the character in this lexer's buffer that the
+  /// specified file location refers to.  This is the inverse of
+  /// getSourceLocation.
+  const char* getBufferLocation(SourceLocation Loc) const {
+    assert(Loc.isFileID() && "Macro location in a lexer buffer?");
+    return BufferStart + (Loc.getRawEncoding() - FileLoc.getRawEncoding());
+  }
+
   //===--------------------------------------------------------------------===//
   // Internal implementation interfaces.
  private:
@@ -256,6 +283,20 @@ class Lexer {
   ///
   void LexTokenInternal(LexerToken& Result);
 
+  /// FormTokenWithChars - The token that starts at Result's location ends at
+  /// TokEnd: set its length and move the lexer past it.
+  void FormTokenWithChars(LexerToken& Result, const char* TokEnd) {
+    Result.SetLength(TokEnd - getBufferLocation(Result.getSourceLocation()));
+    BufferPtr = TokEnd;
+  }
+
+  /// getSpelling - The implementation of the getSpelling methods, for a token
+  /// whose characters start at TokStart.
+  static std::string getSpelling(const LexerToken& Tok, const char* TokStart,
+                                 const LangOptions& Features);
+  static unsigned getSpelling(const LexerToken& Tok, const char* TokStart,
+                              char* Buffer, const LangOptions& Features);
+
   //===--------------------------------------------------------------------===//
   // Lexer character reading interfaces.
 
@@ -332,7 +373,7 @@ class Lexer {
   /// pushConditionalLevel - When we enter a #if directive, this keeps track of
   /// what we are currently in for diagnostic emission (e.g. #if with missing
   /// #endif).
-  void pushConditionalLevel(const char* DirectiveStart, bool WasSkipping,
+  void pushConditionalLevel(SourceLocation DirectiveStart, bool WasSkipping,
                             bool FoundNonSkip, bool FoundElse) {
     PPConditionalInfo CI;
     CI.IfLoc = DirectiveStart;
@@ -365,6 +406,21 @@ class Lexer {
 
   unsigned getConditionalStackDepth() const { return ConditionalStack.size(); }
 
+  /// SkipToPossibleDirective - While the preprocessor skips an excluded
+  /// conditional block, advance over lines that can't start with a directive
+  /// without lexing them.
+  void SkipToPossibleDirective();
+
+  /// SkipRawMacroBody - After the name of a #define, skip a body that can be
+  /// lexed later instead, returning the end of its last token.  Return null if
+  /// it has to be lexed now.
+  const char* SkipRawMacroBody();
+
+  /// isNextPPTokenLParen - Return 1 if the next token in the file is a '(', 0
+  /// if it is something else, or 2 if the file ends first.  This looks at the
+  /// characters without lexing them, so nothing is consumed or diagnosed.
+  unsigned isNextPPTokenLParen() const;
+
   //===--------------------------------------------------------------------===//
   // Other lexer functions.
 
@@ -1,23 +1,124 @@
 #ifndef TINYCLANG_LEXER_MACROEXPANDER_H
 #define TINYCLANG_LEXER_MACROEXPANDER_H
 
+#include <vector>
+
+#include "llvm/ADT/SmallVector.h"
+#include "tinyclang/Lexer/Lexer.h"
+#include "tinyclang/Source/SourceLocation.h"
+
 namespace tinyclang {
 
 class MacroInfo;
 class Preprocessor;
-class LexerToken;
+
+/// MacroArgs - The actual arguments of one invocation of a function-like
+/// macro.  Their tokens live in a buffer that the Preprocessor reuses for every
+/// invocation: each argument is a run of tokens ended by a tok::eof, stored one
+/// after the other from where the buffer ended when the invocation started.
+/// The pre-expansion of an argument is added to the end the first time it is
+/// needed, and used for every other use of its parameter.  Invocations nest,
+/// so the buffer is cut back when this goes away.
+class MacroArgs {
+  /// Tokens - The buffer the arguments are in.  Pre-expanding an argument can
+  /// read other invocations into it, so this is indexed, not pointed into.
+  std::vector<LexerToken>& Tokens;
+
+  /// FirstToken - The size of the buffer before the arguments were added.
+  unsigned FirstToken;
+
+  /// UnexpArgStarts - The index of the first token of each argument as it was
+  /// written.
+  llvm::SmallVector<unsigned, 8> UnexpArgStarts;
+
+  /// PreExpArgStarts - The index of the first token of the pre-expansion of
+  /// each argument, or ~0U if it hasn't been needed yet.
+  llvm::SmallVector<unsigned, 8> PreExpArgStarts;
+
+  /// VarargsElided - True if the variadic argument was left out altogether,
+  /// not just empty.
+  bool VarargsElided;
+
+  MacroArgs(const MacroArgs&) = delete;
+  void operator=(const MacroArgs&) = delete;
+
+ public:
+  explicit MacroArgs(std::vector<LexerToken>& Buffer)
+      : Tokens(Buffer), FirstToken(Buffer.size()), VarargsElided(false) {}
+  ~MacroArgs() { Tokens.resize(FirstToken); }
+
+  std::vector<LexerToken>& getTokens() const { return Tokens; }
+
+  /// StartArgument - Begin a new argument.  The tokens added after this, up to
+  /// the next EndArgument, are its tokens.
+  void StartArgument() {
+    UnexpArgStarts.push_back(Tokens.size());
+    PreExpArgStarts.push_back(~0U);
+  }
+
+  /// EndArgument - End the current argument with a tok::eof at the specified
+  /// location, the ',' or ')' after it.
+  void EndArgument(SourceLocation Loc) {
+    LexerToken Tok;
+    Tok.StartToken();
+    Tok.SetKind(tok::eof);
+    Tok.SetLength(0);
+    Tok.SetLocation(Loc);
+    Tokens.push_back(Tok);
+  }
+
+  unsigned getNumArguments() const { return UnexpArgStarts.size(); }
+
+  bool isVarargsElided() const { return VarargsElided; }
+  void setVarargsElided() { VarargsElided = true; }
+
+  /// getUnexpArgument - Return the index of the first token of the specified
+  /// argument as it was written.  The argument ends with a tok::eof.
+  unsigned getUnexpArgument(unsigned Arg) const {
+    assert(Arg < UnexpArgStarts.size() && "Invalid argument #");
+    return UnexpArgStarts[Arg];
+  }
+
+  /// isArgumentEmpty - Return true if the specified argument has no tokens.
+  bool isArgumentEmpty(unsigned Arg) const {
+    return Tokens[getUnexpArgument(Arg)].getKind() == tok::eof;
+  }
+
+  /// getPreExpArgument/setPreExpArgument - The index of the first token of the
+  /// pre-expansion of the specified argument, ~0U until it has been set.  See
+  /// Preprocessor::getPreExpArgument.
+  unsigned getPreExpArgument(unsigned Arg) const {
+    assert(Arg < PreExpArgStarts.size() && "Invalid argument #");
+    return PreExpArgStarts[Arg];
+  }
+  void setPreExpArgument(unsigned Arg, unsigned Start) {
+    assert(Arg < PreExpArgStarts.size() && "Invalid argument #");
+    PreExpArgStarts[Arg] = Start;
+  }
+};
 
 /// MacroExpander - This implements a lexer that returns token from a macro body
-/// instead of lexing from a character buffer.
+/// instead of lexing from a character buffer.  It can also return the tokens
+/// of a macro argument, see Preprocessor::EnterTokenStream.  It is just a
+/// position in tokens that live elsewhere, and the Preprocessor keeps these by
+/// value on its macro stack.
 ///
 class MacroExpander {
-  /// Macro - The macro we are expanding from.
+  /// Macro - The macro we are expanding from, or null for a token stream.
   ///
-  MacroInfo& Macro;
+  MacroInfo* Macro;
 
-  /// CurMacroID - This encodes the instantiation point of the macro being
-  /// expanded and the include stack.
-  unsigned CurMacroID;
+  /// Tokens/FirstToken/NumTokens - The tokens this returns are NumTokens tokens
+  /// of Tokens, starting at FirstToken: the body of the macro, or its expansion
+  /// if it had to be built, like for a function-like macro.  A token stream
+  /// runs to a tok::eof instead.
+  const std::vector<LexerToken>* Tokens;
+  unsigned FirstToken, NumTokens;
+
+  /// FirstLoc - The macro location of the first token of this expansion.  The
+  /// SourceManager allocated one for each token, consecutively, and they
+  /// encode the expansion point and through it the include stack.
+  SourceLocation FirstLoc;
 
   /// PP - The current preprocessor object we are expanding for.
   ///
@@ -30,17 +131,82 @@ class MacroExpander {
   /// that the macro expanded from had these properties.
   bool AtStartOfLine, HasLeadingSpace;
 
+  /// IsFullyExpanded - True if the tokens are the cached full expansion of the
+  /// macro, which are returned as they are instead of being rescanned.
+  bool IsFullyExpanded;
+
+  /// FirstEndedMacro - The macros of the Preprocessor's EndedMacros from this
+  /// index on end when this does.  See Preprocessor::EnterMacro.
+  unsigned FirstEndedMacro;
+
+  /// ReleaseTokensTo - What the Preprocessor's MacroExpansionTokens is cut back
+  /// to when this ends, or ~0U if it is left alone.
+  unsigned ReleaseTokensTo;
+
  public:
-  MacroExpander(MacroInfo& macro, unsigned MacroID, Preprocessor& pp,
-                bool atStartOfLine, bool hasLeadingSpace)
-      : Macro(macro),
-        CurMacroID(MacroID),
+  /// MacroExpander ctor - Expand the specified macro to the specified tokens.
+  /// Each must have a file location, where it was spelled.  If isFullyExpanded
+  /// is true, they contain no more macros to expand.
+  MacroExpander(MacroInfo& macro, const std::vector<LexerToken>& tokens,
+                unsigned firstToken, unsigned numTokens,
+                SourceLocation firstLoc, Preprocessor& pp, bool atStartOfLine,
+                bool hasLeadingSpace, bool isFullyExpanded)
+      : Macro(&macro),
+        Tokens(&tokens),
+        FirstToken(firstToken),
+        NumTokens(numTokens),
+        FirstLoc(firstLoc),
         PP(pp),
         CurToken(0),
         AtStartOfLine(atStartOfLine),
-        HasLeadingSpace(hasLeadingSpace) {}
+        HasLeadingSpace(hasLeadingSpace),
+        IsFullyExpanded(isFullyExpanded),
+        FirstEndedMacro(0),
+        ReleaseTokensTo(~0U) {}
+
+  /// MacroExpander ctor - Return the tokens starting at the specified one, up
+  /// to and including the next tok::eof, as they are.
+  MacroExpander(const std::vector<LexerToken>& tokens, unsigned firstToken,
+                Preprocessor& pp)
+      : Macro(0),
+        Tokens(&tokens),
+        FirstToken(firstToken),
+        NumTokens(0),
+        PP(pp),
+        CurToken(0),
+        AtStartOfLine(false),
+        HasLeadingSpace(false),
+        IsFullyExpanded(false),
+        FirstEndedMacro(0),
+        ReleaseTokensTo(~0U) {}
+
+  /// getMacro - Return the macro being expanded, or null for a token stream.
+  MacroInfo* getMacro() const { return Macro; }
+
+  const std::vector<LexerToken>& getTokens() const { return *Tokens; }
+  unsigned getFirstToken() const { return FirstToken; }
+  unsigned getNumTokens() const { return NumTokens; }
+
+  /// isAtEnd - Return true if this is a macro expansion that has returned all
+  /// of its tokens, so the next Lex ends it.
+  bool isAtEnd() const { return Macro && CurToken == NumTokens; }
+
+  /// get/setEndState - What ending this expansion involves besides enabling
+  /// its macro, see FirstEndedMacro and ReleaseTokensTo.
+  unsigned getFirstEndedMacro() const { return FirstEndedMacro; }
+  unsigned getReleaseTokensTo() const { return ReleaseTokensTo; }
+  void setEndState(unsigned firstEndedMacro, unsigned releaseTokensTo) {
+    FirstEndedMacro = firstEndedMacro;
+    ReleaseTokensTo = releaseTokensTo;
+  }
 
-  MacroInfo& getMacro() const { return Macro; }
+  /// isNextTokenLParen - Return 1 if the next token is a '(', 0 if it is
+  /// something else, or 2 if the expansion ends first.
+  unsigned isNextTokenLParen() const {
+    if (Macro && CurToken == NumTokens)
+      return 2;
+    return (*Tokens)[FirstToken + CurToken].getKind() == tok::l_paren;
+  }
 
   /// Lex - Lex and return a token from this macro stream.
   void Lex(LexerToken& Tok);
@@ -48,4 +214,4 @@ class MacroExpander {
 
 }  // namespace tinyclang
 
-#endif  // TINYCLANG_LEXER_MACROEXPANDER_H
\ No newline at end of file
+#endif  // TINYCLANG_LEXER_MACROEXPANDER_H
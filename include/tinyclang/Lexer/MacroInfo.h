@@ -2,61 +2,232 @@
 #define TINYCLANG_LEXER_MACROINFO_H
 
 #include <cassert>
+#include <type_traits>
 #include <vector>
 
+#include "llvm/Support/Allocator.h"
 #include "tinyclang/Lexer/Lexer.h"
 #include "tinyclang/Source/SourceLocation.h"
 
 namespace tinyclang {
 
+class IdentifierTokenInfo;
+class Preprocessor;
+
 /// MacroInfo - Each identifier that is #define'd has an instance of this class
-/// associated with it, used to implement macro expansion.
+/// associated with it, used to implement macro expansion.  The Preprocessor
+/// allocates these from an arena and never frees them one by one, so this
+/// must stay trivially destructible.
 class MacroInfo {
   /// Location - This is the place the macro is defined.
   SourceLocation Location;
 
-  /// ReplacementTokens - This is the list of tokens that the macro is defined
-  /// to.
-  std::vector<LexerToken> ReplacementTokens;
+  /// ArgumentList - The parameters of a function-like macro, in order.  For a
+  /// C99 variadic macro the last one is __VA_ARGS__.  This is allocated in the
+  /// macro arena too.
+  IdentifierTokenInfo** ArgumentList;
+  unsigned NumArguments;
+
+  /// FirstToken/NumTokens - The tokens that the macro is defined to, as a slice
+  /// of TokenPool.
+  unsigned FirstToken, NumTokens;
+
+  /// TokenPool - The Preprocessor's pool that the bodies of all macros are
+  /// stored in, end to end.
+  std::vector<LexerToken>* TokenPool;
+
+  /// RawBodyLoc/RawBodyLength - If the body was recorded by setRawBody, this is
+  /// its text, from right after the macro name to the end of its last token.
+  SourceLocation RawBodyLoc;
+  unsigned RawBodyLength;
+
+  /// ExpansionEpoch - The Preprocessor's macro definition epoch that the cached
+  /// full expansion of this macro is valid in, or 0 if nothing is cached.
+  unsigned ExpansionEpoch;
+
+  /// FirstExpansionToken/NumExpansionTokens - The cached full expansion, as a
+  /// slice of the Preprocessor's ExpansionCacheTokens.  NumExpansionTokens is
+  /// ~0U if the expansion can't be cached in ExpansionEpoch.  The slice is
+  /// reused for a later epoch's expansion if it fits in ExpansionCapacity.
+  unsigned FirstExpansionToken, NumExpansionTokens, ExpansionCapacity;
+
+  /// isBodyLexed - False if the body has only been recorded as raw text, and
+  /// nothing has needed its tokens yet.
+  bool isBodyLexed;
 
   /// isDisabled - True if we have started an expansion of this macro already.
   /// This disbles recursive expansion, which would be quite bad for things like
   /// #define A A.
   bool isDisabled;
 
-#if 0
-  /* Number of tokens in expansion, or bytes for traditional macros.  */
-  unsigned int count;
-  /* Number of parameters.  */
-  unsigned short paramc;
-  /* If a function-like macro.  */
-  unsigned int fun_like : 1;
-  /* If a variadic macro.  */
-  unsigned int variadic : 1;
-  /* Nonzero if it has been expanded or had its existence tested.  */
-  unsigned int used     : 1;
-  /* Indicate which field of 'exp' is in use.  */
-  unsigned int traditional : 1;
-#endif
+  /// IsFunctionLike - True if this macro takes arguments: its name was followed
+  /// by a '(' in the #define.
+  bool IsFunctionLike : 1;
+
+  /// IsC99Varargs/IsGNUVarargs - True if the last parameter is '...', which is
+  /// named __VA_ARGS__, or 'name...'.  Either way it takes the rest of the
+  /// arguments, commas and all.
+  bool IsC99Varargs : 1;
+  bool IsGNUVarargs : 1;
+
+  /// HasPaste - True if the body contains a ## operator, so its tokens can't
+  /// just be returned one by one.
+  bool HasPaste : 1;
+
  public:
-  MacroInfo(SourceLocation DefLoc) : Location(DefLoc) { isDisabled = false; }
+  /// MacroInfo ctor - Create a macro with an empty body, which will be added to
+  /// the end of the specified pool.
+  MacroInfo(SourceLocation DefLoc, std::vector<LexerToken>& Pool)
+      : Location(DefLoc),
+        ArgumentList(0),
+        NumArguments(0),
+        FirstToken(Pool.size()),
+        NumTokens(0),
+        TokenPool(&Pool),
+        RawBodyLength(0),
+        ExpansionEpoch(0),
+        FirstExpansionToken(0),
+        NumExpansionTokens(0),
+        ExpansionCapacity(0) {
+    isBodyLexed = true;
+    isDisabled = false;
+    IsFunctionLike = IsC99Varargs = IsGNUVarargs = HasPaste = false;
+  }
+
+  /// getDefinitionLoc - Return the location of the macro name in its #define.
+  SourceLocation getDefinitionLoc() const { return Location; }
+
+  /// setArgumentList - Set the parameters of this function-like macro,
+  /// copying them into the specified arena.
+  void setArgumentList(IdentifierTokenInfo* const* List, unsigned NumArgs,
+                       llvm::BumpPtrAllocator& Arena) {
+    assert(ArgumentList == 0 && "Argument list already set!");
+    if (NumArgs == 0)
+      return;
+    ArgumentList = Arena.Allocate<IdentifierTokenInfo*>(NumArgs);
+    for (unsigned i = 0; i != NumArgs; ++i)
+      ArgumentList[i] = List[i];
+    NumArguments = NumArgs;
+  }
+
+  /// getNumArguments - Return the number of parameters of this function-like
+  /// macro, counting a variadic one.
+  unsigned getNumArguments() const { return NumArguments; }
+  IdentifierTokenInfo* getArgument(unsigned Arg) const {
+    assert(Arg < NumArguments && "Invalid argument #");
+    return ArgumentList[Arg];
+  }
+
+  /// getArgumentNum - Return the number of the parameter with the specified
+  /// name, or -1 if it isn't one.  Macros have few parameters, so this is just
+  /// a linear search.
+  int getArgumentNum(const IdentifierTokenInfo* Arg) const {
+    for (unsigned i = 0; i != NumArguments; ++i)
+      if (ArgumentList[i] == Arg)
+        return i;
+    return -1;
+  }
+
+  void setIsFunctionLike() { IsFunctionLike = true; }
+  bool isFunctionLike() const { return IsFunctionLike; }
+
+  void setIsC99Varargs() { IsC99Varargs = true; }
+  void setIsGNUVarargs() { IsGNUVarargs = true; }
+  bool isC99Varargs() const { return IsC99Varargs; }
+  bool isGNUVarargs() const { return IsGNUVarargs; }
+  bool isVariadic() const { return IsC99Varargs | IsGNUVarargs; }
+
+  /// hasPaste - Return true if the body contains a ## operator.
+  bool hasPaste() const { return HasPaste; }
+
+  /// setRawBody - Record the text of the body instead of its tokens.  The
+  /// Preprocessor lexes it with LexMacroBody the first time the tokens are
+  /// needed.
+  void setRawBody(SourceLocation Loc, unsigned Length) {
+    assert(NumTokens == 0 && "Macro already has a body!");
+    RawBodyLoc = Loc;
+    RawBodyLength = Length;
+    isBodyLexed = false;
+  }
+
+  /// hasRawBody - Return true if the body was recorded with setRawBody, lexed
+  /// or not.
+  bool hasRawBody() const { return RawBodyLoc.isValid(); }
+  SourceLocation getRawBodyLoc() const { return RawBodyLoc; }
+  unsigned getRawBodyLength() const { return RawBodyLength; }
+
+  /// isLexed - Return true if the tokens of the body are available.
+  bool isLexed() const { return isBodyLexed; }
+
+  /// StartLexedBody - The body recorded by setRawBody is about to be lexed:
+  /// its tokens are added to the end of the pool from now on.
+  void StartLexedBody() {
+    assert(!isBodyLexed && "Body already lexed!");
+    FirstToken = TokenPool->size();
+    isBodyLexed = true;
+  }
 
   /// getNumTokens - Return the number of tokens that this macro expands to.
   ///
-  unsigned getNumTokens() const { return ReplacementTokens.size(); }
+  unsigned getNumTokens() const {
+    assert(isBodyLexed && "Body hasn't been lexed yet!");
+    return NumTokens;
+  }
 
   const LexerToken& getReplacementToken(unsigned Tok) const {
-    assert(Tok < ReplacementTokens.size() && "Invalid token #");
-    return ReplacementTokens[Tok];
+    assert(Tok < NumTokens && "Invalid token #");
+    return (*TokenPool)[FirstToken + Tok];
   }
 
+  /// getTokenPool/getFirstTokenIndex - The body is the getNumTokens() tokens
+  /// of the pool starting at getFirstTokenIndex().  Defining a macro can grow
+  /// the pool while the body is in use, so hold on to indices, not pointers.
+  const std::vector<LexerToken>& getTokenPool() const { return *TokenPool; }
+  unsigned getFirstTokenIndex() const { return FirstToken; }
+
+  /// isIdenticalTo - Return true if the specified macro has the same parameters
+  /// and body as this one: the same tokens with the same whitespace separation.
+  /// Bodies that haven't been lexed are lexed if their text differs.
+  bool isIdenticalTo(MacroInfo& Other, Preprocessor& PP);
+
   /// AddTokenToBody - Add the specified token to the replacement text for the
-  /// macro.
+  /// macro.  The token keeps its location, which becomes the spelling location
+  /// of the tokens expanded from it.  The body must still be the last thing in
+  /// the pool.
   void AddTokenToBody(const LexerToken& Tok) {
-    ReplacementTokens.push_back(Tok);
-    // FIXME: Remember where this token came from, do something intelligent with
-    // its location.
-    ReplacementTokens.back().ClearPosition();
+    assert(FirstToken + NumTokens == TokenPool->size() &&
+           "Another macro was defined in the middle of this one!");
+    TokenPool->push_back(Tok);
+    ++NumTokens;
+    if (Tok.getKind() == tok::hashhash)
+      HasPaste = true;
+  }
+
+  /// hasCachedExpansion - Return true if the full expansion of this macro was
+  /// cached in the specified epoch, which getNumExpansionTokens says whether it
+  /// could be.
+  bool hasCachedExpansion(unsigned Epoch) const {
+    return ExpansionEpoch == Epoch;
+  }
+  unsigned getFirstExpansionToken() const { return FirstExpansionToken; }
+  unsigned getNumExpansionTokens() const { return NumExpansionTokens; }
+  unsigned getExpansionCapacity() const { return ExpansionCapacity; }
+
+  /// setCachedExpansion - Record the full expansion of this macro in the
+  /// specified epoch.  Capacity is the size of the slice it is in.
+  void setCachedExpansion(unsigned Epoch, unsigned First, unsigned Num,
+                          unsigned Capacity) {
+    ExpansionEpoch = Epoch;
+    FirstExpansionToken = First;
+    NumExpansionTokens = Num;
+    ExpansionCapacity = Capacity;
+  }
+
+  /// setUncacheableExpansion - Record that the expansion of this macro can't be
+  /// cached in the specified epoch.  The slice of a previous one is kept.
+  void setUncacheableExpansion(unsigned Epoch) {
+    ExpansionEpoch = Epoch;
+    NumExpansionTokens = ~0U;
   }
 
   /// isEnabled - Return true if this macro is enabled: in other words, that we
@@ -75,12 +246,15 @@ class MacroInfo {
 
   /// dump - Print the macro to stderr, used for debugging.
   ///
-  void dump(const LangOptions& Features) const;
+  void dump(const SourceManager& SourceMgr, const LangOptions& Features) const;
 
   // Todo:
   // bool isDefinedInSystemHeader() { Look this up based on Location }
 };
 
+static_assert(std::is_trivially_destructible<MacroInfo>::value,
+              "MacroInfos are never destroyed");
+
 }  // namespace tinyclang
 
 #endif  // TINYCLANG_LEXER_MACROINFO_H
\ No newline at end of file
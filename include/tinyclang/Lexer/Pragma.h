@@ -0,0 +1,76 @@
+#ifndef TINYCLANG_LEXER_PRAGMA_H
+#define TINYCLANG_LEXER_PRAGMA_H
+
+#include <cassert>
+
+#include "llvm/ADT/DenseMap.h"
+
+namespace tinyclang {
+
+class Preprocessor;
+class LexerToken;
+class IdentifierTokenInfo;
+class PragmaNamespace;
+
+/// PragmaHandler - Instances of this interface defined to handle the various
+/// pragmas that the language front-end uses.  Each handler has a name (e.g.
+/// "once") and the HandlePragma method is invoked when a pragma with that name
+/// is found.  Handlers are looked up by the uniqued IdentifierTokenInfo of the
+/// name, so dispatching a pragma never compares strings.
+///
+/// Note that the PragmaNamespace class can be used to subdivide pragmas, e.g.
+/// "#pragma GCC" can be a namespace that contains other pragmas.
+class PragmaHandler {
+  const IdentifierTokenInfo* Name;
+
+ public:
+  PragmaHandler(const IdentifierTokenInfo* name) : Name(name) {}
+  virtual ~PragmaHandler();
+
+  const IdentifierTokenInfo* getName() const { return Name; }
+
+  /// HandlePragma - Handle the pragma.  FirstToken is the name of the pragma,
+  /// the rest of the line is still in the lexer.  Handlers need not read up to
+  /// the end of the line, the caller discards whatever is left.
+  virtual void HandlePragma(Preprocessor& PP, LexerToken& FirstToken) = 0;
+
+  /// getIfNamespace - If this is a namespace, return it.  This is equivalent to
+  /// using a dynamic_cast, but doesn't require RTTI.
+  virtual PragmaNamespace* getIfNamespace() { return 0; }
+};
+
+/// PragmaNamespace - This PragmaHandler subdivides the namespace of pragmas,
+/// allowing hierarchical pragmas to be defined.  Common examples of namespaces
+/// are "#pragma GCC", "#pragma STDC", and "#pragma omp", but any namespaces may
+/// be (potentially recursively) defined.
+class PragmaNamespace : public PragmaHandler {
+  /// Handlers - This is the set of handlers in this namespace, keyed by the
+  /// identifier they handle.  These are owned by the namespace.
+  llvm::DenseMap<const IdentifierTokenInfo*, PragmaHandler*> Handlers;
+
+ public:
+  PragmaNamespace(const IdentifierTokenInfo* Name) : PragmaHandler(Name) {}
+  virtual ~PragmaNamespace();
+
+  /// FindHandler - Check to see if there is already a handler for the
+  /// specified name.  If not, return null.
+  PragmaHandler* FindHandler(const IdentifierTokenInfo* Name) const {
+    auto I = Handlers.find(Name);
+    return I == Handlers.end() ? 0 : I->second;
+  }
+
+  /// AddPragma - Add a pragma to this namespace.  The namespace takes ownership
+  /// of the handler.
+  void AddPragma(PragmaHandler* Handler) {
+    assert(!Handlers.count(Handler->getName()) && "Pragma already registered!");
+    Handlers[Handler->getName()] = Handler;
+  }
+
+  virtual void HandlePragma(Preprocessor& PP, LexerToken& FirstToken);
+
+  virtual PragmaNamespace* getIfNamespace() { return this; }
+};
+
+}  // namespace tinyclang
+
+#endif  // TINYCLANG_LEXER_PRAGMA_H
\ No newline at end of file
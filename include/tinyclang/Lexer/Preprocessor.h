@@ -1,6 +1,9 @@
 #ifndef TINYCLANG_LEXER_PREPROCESSOR_H
 #define TINYCLANG_LEXER_PREPROCESSOR_H
 
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Allocator.h"
 #include "tinyclang/Lexer/IdentifierTable.h"
 #include "tinyclang/Lexer/Lexer.h"
 #include "tinyclang/Lexer/MacroExpander.h"
@@ -14,6 +17,10 @@ class SourceManager;
 class FileManager;
 class DirectoryEntry;
 class FileEntry;
+class PragmaNamespace;
+class PragmaHandler;
+class MacroInfo;
+class ScratchBuffer;
 
 /// DirectoryLookup - This class is used to specify the search order for
 /// directories in #include directives.
@@ -72,6 +79,27 @@ class Preprocessor {
   unsigned SystemDirIdx;
   bool NoCurDirSearch;
 
+  /// LookupFileCacheInfo - The memoized result of searching SearchDirs for one
+  /// #include spelling: the file found, and the index of the directory it was
+  /// found in (SearchDirs.size() if it wasn't found).
+  struct LookupFileCacheInfo {
+    const FileEntry* File;
+    unsigned HitIdx;
+    LookupFileCacheInfo() : File(0), HitIdx(0) {}
+  };
+
+  /// SearchDirCache - Memoized results of LookupFile's directory search.  This
+  /// is indexed by the SearchDirs index the search started at (which is how
+  /// <> vs "" and #include_next differ), then by the spelling of the name.
+  /// The same headers are #included over and over from different places, and
+  /// each would otherwise walk the search path again.
+  std::vector<llvm::StringMap<LookupFileCacheInfo> > SearchDirCache;
+
+  /// IncluderDirCache - Memoized results of looking up #include "x" in the
+  /// directory of the #including file, keyed by that directory.
+  llvm::DenseMap<const DirectoryEntry*, llvm::StringMap<const FileEntry*> >
+      IncluderDirCache;
+
   enum {
     /// MaxIncludeStackDepth - Maximum depth of #includes.
     MaxAllowedIncludeStackDepth = 200
@@ -81,10 +109,63 @@ class Preprocessor {
   bool DisableMacroExpansion;  // True if macro expansion is disabled.
   bool SkippingContents;       // True if in a #if 0 block.
 
+  /// LexAgain - Set by a callback that entered or ended a macro expansion
+  /// instead of returning a token, which Lex then lexes from wherever that
+  /// left it.  Expanding a chain of macros is a loop, not a recursion.
+  bool LexAgain;
+
+  /// EmptyMacroFlags - Set along with LexAgain by the expansion of a macro to
+  /// nothing: the StartOfLine and LeadingSpace flags of its name, which the
+  /// token returned in its place inherits.
+  unsigned EmptyMacroFlags;
+
+  /// LazyMacroBodies - If true, #define records the text of a macro's body,
+  /// and it is only lexed when the macro is first expanded.
+  bool LazyMacroBodies;
+
+  /// CacheMacroExpansions - If true, the full expansions of object-like macros
+  /// are cached, see setCacheMacroExpansions.
+  bool CacheMacroExpansions;
+
+  /// NumDisabledMacros - The number of macros that are being expanded, and so
+  /// are disabled.  While this is 0, an object-like macro expands to the same
+  /// tokens wherever it is used.
+  unsigned NumDisabledMacros;
+
   /// IdentifierInfo - This is mapping/lookup information for all identifiers in
   /// the program, including program keywords.
   IdentifierTable IdentifierInfo;
 
+  /// Ident__VA_ARGS__ - The name of the variadic parameter of a C99 variadic
+  /// macro.
+  IdentifierTokenInfo* Ident__VA_ARGS__;
+
+  /// Ident_defined - The 'defined' operator of #if, which stops the expansion
+  /// of the name after it.
+  IdentifierTokenInfo* Ident_defined;
+
+  /// ScratchBuf - This is where the tokens made by stringizing and pasting are
+  /// spelled.
+  ScratchBuffer* ScratchBuf;
+
+  /// MacroArena - The MacroInfo of every #define is allocated here.  They are
+  /// never freed one by one: an #undef'd or redefined macro's MacroInfo and
+  /// body stay around until the Preprocessor is destroyed.
+  llvm::BumpPtrAllocator MacroArena;
+
+  /// MacroTokens - The bodies of all macros, end to end.  Each MacroInfo owns a
+  /// slice of this.
+  std::vector<LexerToken> MacroTokens;
+
+  /// MacroDefinitionEpoch - This is bumped by every #define and #undef.  A full
+  /// expansion cached in an earlier epoch may refer to a macro that has changed
+  /// since, so it is only used in the epoch it was cached in.
+  unsigned MacroDefinitionEpoch;
+
+  /// ExpansionCacheTokens - The cached full expansions of object-like macros,
+  /// end to end.  Each MacroInfo with one owns a slice of this.
+  std::vector<LexerToken> ExpansionCacheTokens;
+
   /// CurLexer - This is the current top of the stack that we're lexing from if
   /// not expanding a macro.  One of CurLexer and CurMacroExpander must be null.
   ///
@@ -105,12 +186,37 @@ class Preprocessor {
   std::vector<IncludeStackInfo> IncludeStack;
 
   /// CurMacroExpander - This is the current macro we are expanding, if we are
-  /// expanding a macro.  One of CurLexer and CurMacroExpander must be null.
+  /// expanding a macro: the last element of MacroStack.  One of CurLexer and
+  /// CurMacroExpander must be null.
   MacroExpander* CurMacroExpander;
 
-  /// MacroStack - This keeps track of the macros that are recursively being
-  /// expanded.
-  std::vector<MacroExpander*> MacroStack;
+  /// MacroStack - The macros that are recursively being expanded, and the
+  /// token streams being lexed, innermost last.  The expanders are kept by
+  /// value and only hold indices into the token buffers they return, so once
+  /// this has grown to the deepest nesting, entering a macro allocates
+  /// nothing.  Pushing can move the expanders, which is why nothing else
+  /// points into this.
+  std::vector<MacroExpander> MacroStack;
+
+  /// EndedMacros - Macros whose expanders ran out of tokens and were popped
+  /// when the macro named by their last token was entered.  They stay
+  /// disabled until the expander that took their place ends, when they would
+  /// have ended.
+  std::vector<MacroInfo*> EndedMacros;
+
+  /// MacroArgTokens - The arguments of the function-like macro invocations
+  /// being expanded, and their pre-expansions.  See MacroArgs.
+  std::vector<LexerToken> MacroArgTokens;
+
+  /// MacroExpansionTokens - The expansions of the function-like macros (and
+  /// macros that paste tokens) being expanded, innermost last.  Each
+  /// MacroExpander returning one of these owns the end of this, and gives it
+  /// back when it is done.
+  std::vector<LexerToken> MacroExpansionTokens;
+
+  /// PragmaHandlers - This tracks all of the pragmas that the client registered
+  /// with this preprocessor.
+  PragmaNamespace* PragmaHandlers;
 
   /// PreFileInfo - The preprocessor keeps track of this information for each
   /// file that is #included.
@@ -122,7 +228,12 @@ class Preprocessor {
     // already.
     unsigned short NumIncludes;
 
-    PerFileInfo() : isImport(false), NumIncludes(0) {}
+    // ControllingMacro - If this file is wrapped in #ifndef FOO/#endif with
+    // nothing outside, this is FOO.  While FOO is defined, including the file
+    // again would produce no tokens, so it isn't entered at all.
+    const IdentifierTokenInfo* ControllingMacro;
+
+    PerFileInfo() : isImport(false), NumIncludes(0), ControllingMacro(0) {}
   };
 
   /// FileInfo - This contains all of the preprocessor-specific data about files
@@ -135,7 +246,13 @@ class Preprocessor {
   unsigned NumIf, NumElse, NumEndif;
   unsigned NumEnteredSourceFiles, MaxIncludeStackDepth;
   unsigned NumMacroExpanded, NumFastMacroExpanded, MaxMacroStackDepth;
-  unsigned NumSkipped;
+  unsigned NumFnMacroExpanded, NumMacroArgs, NumPreExpandedArgs;
+  unsigned NumReusedPreExpandedArgs;
+  unsigned NumRawMacroBodies, NumLexedRawMacroBodies, NumMacroRedefinitions;
+  unsigned NumExpansionCacheHits, NumExpansionCacheFills;
+  unsigned NumSkipped, NumMultiIncludeFileOptzn;
+  unsigned NumSearchCacheHits, NumSearchCacheMisses;
+  unsigned NumIncluderCacheHits, NumIncluderCacheMisses;
 
  public:
   Preprocessor(Diagnostic& diags, const LangOptions& opts, FileManager& FM,
@@ -149,10 +266,31 @@ class Preprocessor {
 
   IdentifierTable& getIdentifierTable() { return IdentifierInfo; }
 
+  /// getNumEnteredSourceFiles - Return how many files have been entered: the
+  /// main file, and each #include that wasn't skipped.
+  unsigned getNumEnteredSourceFiles() const { return NumEnteredSourceFiles; }
+
   /// isSkipping - Return true if we're lexing a '#if 0' block.  This causes
   /// lexer errors/warnings to get ignored.
   bool isSkipping() const { return SkippingContents; }
 
+  /// setLazyMacroBodies - When set to true, the bodies of object-like macros
+  /// are lexed the first time they are expanded, not when they are #defined.
+  /// Most macros a system header defines are never expanded.  Macros whose
+  /// bodies would be diagnosed by the lexer are always lexed when they are
+  /// defined, so nothing changes but the time spent.
+  void setLazyMacroBodies(bool Val) { LazyMacroBodies = Val; }
+  bool getLazyMacroBodies() const { return LazyMacroBodies; }
+
+  /// setCacheMacroExpansions - When set to true, the first expansion of an
+  /// object-like macro outside of any other expansion is cached, and later ones
+  /// return the cached tokens instead of rescanning the body for macros, until
+  /// a #define or #undef.  Macros whose expansion could depend on the tokens
+  /// around it, because a function-like macro, ## or 'defined' is involved,
+  /// are expanded as usual.
+  void setCacheMacroExpansions(bool Val) { CacheMacroExpansions = Val; }
+  bool getCacheMacroExpansions() const { return CacheMacroExpansions; }
+
   /// isCurrentLexer - Return true if we are lexing directly from the specified
   /// lexer.
   bool isCurrentLexer(const Lexer* L) const { return CurLexer == L; }
@@ -164,13 +302,17 @@ class Preprocessor {
     SearchDirs = dirs;
     SystemDirIdx = systemDirIdx;
     NoCurDirSearch = noCurDirSearch;
+
+    // Any memoized searches were done against the old search path.
+    SearchDirCache.clear();
   }
 
   /// getIdentifierInfo - Return information about the specified preprocessor
   /// identifier token.  The version of this method that takes two character
   /// pointers is preferred unless the identifier is already available as a
   /// string (this avoids allocation and copying of memory to construct an
-  /// std::string).
+  /// std::string).  If the caller has the IdentifierTable::HashString of the
+  /// name already, passing it saves hashing it again.
   IdentifierTokenInfo* getIdentifierInfo(const char* NameStart,
                                          const char* NameEnd) {
     // If we are in a "#if 0" block, don't bother lookup up identifiers.
@@ -178,6 +320,14 @@ class Preprocessor {
       return 0;
     return &IdentifierInfo.get(NameStart, NameEnd);
   }
+  IdentifierTokenInfo* getIdentifierInfo(const char* NameStart,
+                                         const char* NameEnd,
+                                         unsigned FullHash) {
+    // If we are in a "#if 0" block, don't bother lookup up identifiers.
+    if (SkippingContents)
+      return 0;
+    return &IdentifierInfo.get(NameStart, NameEnd, FullHash);
+  }
   IdentifierTokenInfo* getIdentifierInfo(const std::string& Name) {
     // If we are in a "#if 0" block, don't bother lookup up identifiers.
     if (SkippingContents)
@@ -185,30 +335,11 @@ class Preprocessor {
     return &IdentifierInfo.get(Name);
   }
 
-  /// AddKeyword - This method is used to associate a token ID with specific
-  /// identifiers because they are language keywords.  This causes the lexer to
-  /// automatically map matching identifiers to specialized token codes.
-  ///
-  /// The C90/C99/CPP flags are set to 0 if the token should be enabled in the
-  /// specified langauge, set to 1 if it is an extension in the specified
-  /// language, and set to 2 if disabled in the specified language.
-  void AddKeyword(const std::string& Keyword, tok::TokenKind TokenCode, int C90,
-                  int C99, int CPP) {
-    int Flags = Features.CPlusPlus ? CPP : (Features.C99 ? C99 : C90);
-
-    // Don't add this keyword if disabled in this language or if an extension
-    // and extensions are disabled.
-    if (Flags + Features.NoExtensions >= 2)
-      return;
-
-    IdentifierTokenInfo& Info = *getIdentifierInfo(Keyword);
-    Info.setTokenID(TokenCode);
-    Info.setIsExtensionToken(Flags == 1);
-  }
-
-  /// AddKeywords - Add all keywords to the symbol table.
-  ///
-  void AddKeywords();
+  /// AddPragmaHandler - Add the specified pragma handler to the preprocessor.
+  /// If 'Namespace' is non-null, then it is a token required to exist on the
+  /// pragma line before the pragma string starts, e.g. "STDC" or "GCC".  The
+  /// preprocessor takes ownership of the handler.
+  void AddPragmaHandler(const char* Namespace, PragmaHandler* Handler);
 
   /// LookupFile - Given a "foo" or <foo> reference, look up the indicated file,
   /// return null on failure.  isSystem indicates whether the file reference is
@@ -216,7 +347,7 @@ class Preprocessor {
   /// DirectoryLookup member the file was found in, or null if not applicable.
   /// If FromDir is non-null, the directory search should start with the entry
   /// after the indicated lookup.  This is used to implement #include_next.
-  const FileEntry* LookupFile(const std::string& Filename, bool isSystem,
+  const FileEntry* LookupFile(llvm::StringRef Filename, bool isSystem,
                               const DirectoryLookup* FromDir,
                               const DirectoryLookup*& NextDir);
 
@@ -225,8 +356,28 @@ class Preprocessor {
   void EnterSourceFile(unsigned CurFileID, const DirectoryLookup* Dir);
 
   /// EnterMacro - Add a Macro to the top of the include stack and start lexing
-  /// tokens from it instead of the current buffer.
-  void EnterMacro(LexerToken& Identifier);
+  /// tokens from it instead of the current buffer.  The expansion of the macro
+  /// named by Identifier is NumTokens tokens of Toks from FirstToken on.  If
+  /// FullyExpanded is true, they are returned without being rescanned.  An
+  /// expansion on top that has no tokens left is popped first, and ends along
+  /// with this one.
+  void EnterMacro(LexerToken& Identifier, MacroInfo& MI,
+                  const std::vector<LexerToken>& Toks, unsigned FirstToken,
+                  unsigned NumTokens, bool FullyExpanded);
+
+  /// EnterTokenStream - Add a lexer to the top of the include stack that
+  /// returns the tokens of Toks from FirstToken up to a tok::eof, which it
+  /// returns as many times as it is asked.  Pop it with RemoveTopOfLexerStack.
+  void EnterTokenStream(const std::vector<LexerToken>& Toks,
+                        unsigned FirstToken);
+
+  /// RemoveTopOfLexerStack - Pop the token stream on top of the include stack,
+  /// and go back to lexing from whatever was there before.
+  void RemoveTopOfLexerStack();
+
+  /// LexMacroBody - Lex the body of a macro that was defined with only the
+  /// text of its body recorded.  See setLazyMacroBodies.
+  void LexMacroBody(MacroInfo& MI);
 
   /// Lex - To lex a token from the preprocessor, just pull a token from the
   /// current lexer or macro object.
@@ -235,8 +386,16 @@ class Preprocessor {
       CurLexer->Lex(Result);
     else
       CurMacroExpander->Lex(Result);
+    if (LexAgain)
+      LexUntilToken(Result);
   }
 
+  /// LexBatch - Lex up to N tokens into Out, stopping after the tok::eof token.
+  /// Return the number of tokens written.  This is the same as calling Lex N
+  /// times, but stays in the current lexer or macro's loop for as long as it
+  /// keeps producing the tokens.
+  unsigned LexBatch(LexerToken* Out, unsigned N);
+
   /// LexUnexpandedToken - This is just like Lex, but this disables macro
   /// expansion of identifier tokens.
   void LexUnexpandedToken(LexerToken& Result) {
@@ -250,6 +409,15 @@ class Preprocessor {
     DisableMacroExpansion = OldVal;
   }
 
+  /// getSpelling - Return the spelling of the specified token, which may come
+  /// from any file or macro expansion.  See Lexer::getSpelling.
+  std::string getSpelling(const LexerToken& Tok) const {
+    return Lexer::getSpelling(Tok, SourceMgr, Features);
+  }
+  unsigned getSpelling(const LexerToken& Tok, char* Buffer) const {
+    return Lexer::getSpelling(Tok, Buffer, SourceMgr, Features);
+  }
+
   /// Diag - Forwarding function for diagnostics.  This emits a diagnostic at
   /// the specified LexerToken's location, translating the token's start
   /// position in the current buffer into a SourcePosition object for rendering.
@@ -266,7 +434,8 @@ class Preprocessor {
   /// HandleIdentifier - This callback is invoked when the lexer reads an
   /// identifier and has filled in the tokens IdentifierInfo member.  This
   /// callback potentially macro expands it or turns it into a named token (like
-  /// 'for').
+  /// 'for').  If it enters a macro expansion, or expands a macro to nothing, it
+  /// sets LexAgain.
   void HandleIdentifier(LexerToken& Identifier);
 
   /// HandleEndOfFile - This callback is invoked when the lexer hits the end of
@@ -275,8 +444,8 @@ class Preprocessor {
   void HandleEndOfFile(LexerToken& Result);
 
   /// HandleEndOfMacro - This callback is invoked when the lexer hits the end of
-  /// the current macro line.
-  void HandleEndOfMacro(LexerToken& Result);
+  /// the current macro line.  It pops the macro and sets LexAgain.
+  void HandleEndOfMacro();
 
   /// HandleDirective - This callback is invoked when the lexer sees a # token
   /// at the start of a line.  This consumes the directive, modifies the
@@ -284,11 +453,83 @@ class Preprocessor {
   /// read is the correct one.
   void HandleDirective(LexerToken& Result);
 
+  /// HandlePragmaOnce - Handle #pragma once.  OnceTok is the 'once'.
+  ///
+  void HandlePragmaOnce(LexerToken& OnceTok);
+
  private:
   /// getFileInfo - Return the PerFileInfo structure for the specified
   /// FileEntry.
   PerFileInfo& getFileInfo(const FileEntry* FE);
 
+  /// RegisterBuiltinPragmas - Install the standard preprocessor pragmas:
+  /// #pragma once.
+  void RegisterBuiltinPragmas();
+
+  /// PushIncludeMacroStack - Save the lexer we are lexing from, if any, on the
+  /// include stack, to start lexing from the new macro expander on top of
+  /// MacroStack.
+  void PushIncludeMacroStack();
+
+  /// PopMacroStack - Pop the macro expander on top of MacroStack, and go back
+  /// to lexing from the one below it or the lexer it was entered from.
+  void PopMacroStack();
+
+  /// LexUntilToken - A callback set LexAgain instead of returning a token in
+  /// Result.  Lex until one is returned.
+  void LexUntilToken(LexerToken& Result);
+
+  /// HandleMacroExpandedIdentifier - The specified identifier names an enabled
+  /// macro: expand it.  Either return the token to use in its place in
+  /// Identifier, or enter the expansion (or skip an empty one) and set
+  /// LexAgain.  Return false if
+  /// this is a function-like macro whose name isn't followed by a '(', so it
+  /// is not expanded after all.
+  bool HandleMacroExpandedIdentifier(LexerToken& Identifier, MacroInfo* MI);
+
+  /// isExpansionCacheable - Return true if the expansion of the specified
+  /// object-like macro is worth caching and can't depend on the tokens around
+  /// it: it expands to other macros, and neither it nor they use a
+  /// function-like macro, ## or 'defined'.
+  bool isExpansionCacheable(MacroInfo& MI);
+
+  /// CacheExpansion - Fully expand the specified object-like macro, which must
+  /// be cacheable, and cache the result in the current epoch.
+  void CacheExpansion(MacroInfo& MI);
+
+  /// isNextPPTokenLParen - Return true if the next token, looking through the
+  /// ends of macro expansions but not of files, is a '('.  This consumes
+  /// nothing.
+  bool isNextPPTokenLParen();
+
+  /// ReadFunctionLikeMacroArgs - The name of a function-like macro has been
+  /// read and the next token is a '('.  Read the arguments of the invocation
+  /// into Args, which is empty.  If they are bad, diagnose them and return
+  /// false with the token to return in place of the expansion in MacroName.
+  bool ReadFunctionLikeMacroArgs(LexerToken& MacroName, MacroInfo& MI,
+                                 MacroArgs& Args);
+
+  /// ExpandFunctionArguments - Add the tokens of the expansion of the specified
+  /// macro to the end of MacroExpansionTokens: its body, with the arguments
+  /// substituted for the parameters, # and ## applied.  Each token gets the
+  /// file location it was spelled at.
+  void ExpandFunctionArguments(MacroInfo& MI, MacroArgs& Args);
+
+  /// getPreExpArgument - Return the index in MacroArgTokens of the first token
+  /// of the specified argument after it has been fully macro expanded, like it
+  /// is before it is substituted for its parameter (C99 6.10.3.1).  This is
+  /// only done once per argument of an invocation.
+  unsigned getPreExpArgument(MacroArgs& Args, unsigned Arg);
+
+  /// StringifyArgument - Implement C99 6.10.3.2: return a string literal
+  /// token that spells the specified argument.
+  LexerToken StringifyArgument(MacroArgs& Args, unsigned Arg);
+
+  /// PasteTokens - Implement C99 6.10.3.3: replace Toks[RHS-1] and Toks[RHS]
+  /// with the token their spellings form together.  If they don't form one
+  /// token, diagnose it and leave them alone.
+  void PasteTokens(std::vector<LexerToken>& Toks, unsigned RHS);
+
   /// DiscardUntilEndOfDirective - Read and discard all tokens remaining on the
   /// current line until the tok::eom token is found.
   void DiscardUntilEndOfDirective();
@@ -310,7 +551,7 @@ class Preprocessor {
   /// FoundElse is false, then #else directives are ok, if not, then we have
   /// already seen one so a #else directive is a duplicate.  When this returns,
   /// the caller can lex the first valid token.
-  void SkipExcludedConditionalBlock(const char* IfTokenLoc,
+  void SkipExcludedConditionalBlock(SourceLocation IfTokenLoc,
                                     bool FoundNonSkipPortion, bool FoundElse);
 
   /// EvaluateDirectiveExpression - Evaluate an integer constant expression that
@@ -339,10 +580,16 @@ class Preprocessor {
 
   // Macro handling.
   void HandleDefineDirective(LexerToken& Result);
+  bool ReadMacroDefinitionArgList(MacroInfo* MI, LexerToken& Tok);
   void HandleUndefDirective(LexerToken& Result);
+  void DefineMacro(const LexerToken& MacroNameTok, MacroInfo* MI);
 
   // Conditional Inclusion.
-  void HandleIfdefDirective(LexerToken& Result, bool isIfndef);
+  void HandleIfdefDirective(LexerToken& Result, bool isIfndef,
+                            bool ReadAnyTokensBeforeDirective);
+
+  // Pragmas.
+  void HandlePragmaDirective();
   void HandleIfDirective(LexerToken& Result);
   void HandleEndifDirective(LexerToken& Result);
   void HandleElseDirective(LexerToken& Result);
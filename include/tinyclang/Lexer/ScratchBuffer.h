@@ -0,0 +1,41 @@
+#ifndef TINYCLANG_LEXER_SCRATCHBUFFER_H
+#define TINYCLANG_LEXER_SCRATCHBUFFER_H
+
+#include "tinyclang/Source/SourceLocation.h"
+
+namespace tinyclang {
+
+class SourceManager;
+
+/// ScratchBuffer - This class exposes a simple interface for the dynamic
+/// construction of tokens, like the results of stringizing and token pasting.
+/// The text is kept in memory buffers that the SourceManager owns, so the
+/// tokens get file locations like any other.
+class ScratchBuffer {
+  SourceManager& SourceMgr;
+
+  /// CurBuffer - The start of the buffer that text is currently added to.
+  char* CurBuffer;
+
+  /// BufferStartLoc - The location of the first character of CurBuffer.
+  SourceLocation BufferStartLoc;
+
+  /// BufferSize/BytesUsed - The size of CurBuffer, and the number of its
+  /// characters handed out so far.
+  unsigned BufferSize, BytesUsed;
+
+ public:
+  explicit ScratchBuffer(SourceManager& SM);
+
+  /// getToken - Copy the specified text into the scratch buffer and return the
+  /// location of its first character.  The text is followed by a newline, so a
+  /// lexer in directive mode stops with an eom token after it.
+  SourceLocation getToken(const char* Buf, unsigned Len);
+
+ private:
+  void AllocScratchBuffer(unsigned RequestLen);
+};
+
+}  // namespace tinyclang
+
+#endif  // TINYCLANG_LEXER_SCRATCHBUFFER_H
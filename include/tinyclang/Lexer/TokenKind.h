@@ -15,6 +15,15 @@ enum TokenKind : uint8_t {
   NUM_TOKENS
 };
 
+/// PPKeywordKind - The preprocessor directive names.  Every identifier has
+/// one, pp_not_keyword for most.
+enum PPKeywordKind : uint8_t {
+  pp_not_keyword,
+#define PPKEYWORD(Name) pp_##Name,
+#include "tinyclang/Lexer/TokenKind.def"
+  NUM_PP_KEYWORDS
+};
+
 auto getTokenName(enum TokenKind kind) -> llvm::StringRef;
 
 }  // namespace tinyclang::tok
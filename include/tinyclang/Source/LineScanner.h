@@ -0,0 +1,33 @@
+#ifndef TINYCLANG_SOURCE_LINESCANNER_H
+#define TINYCLANG_SOURCE_LINESCANNER_H
+
+#include <vector>
+
+namespace tinyclang {
+
+/// LineScanKind - The implementations of the physical line scanner.  Vector
+/// implementations are only used when the host CPU supports them.
+enum class LineScanKind { Scalar, SSE2, AVX2 };
+
+/// getBestLineScanKind - Return the fastest scanner the host CPU supports.  The
+/// check is done once and cached.
+auto getBestLineScanKind() -> LineScanKind;
+
+/// isLineScanKindSupported - Return true if the host CPU can run the specified
+/// scanner.
+auto isLineScanKindSupported(LineScanKind kind) -> bool;
+
+/// computeLineOffsets - Append the file offset of the start of each *physical*
+/// source line in [buf_start, buf_end) to line_offsets, then buf_end's offset.
+/// Line #1 starting at offset 0 is not appended.  \n, \r, \r\n and \n\r each
+/// end a line.  Embedded NULs are skipped.  buf_end[0] must be a NUL, as it is
+/// for every buffer the SourceManager hands to the Lexer.
+///
+/// All kinds produce identical tables.
+void computeLineOffsets(const char* buf_start, const char* buf_end,
+                        std::vector<unsigned>& line_offsets,
+                        LineScanKind kind = getBestLineScanKind());
+
+}  // namespace tinyclang
+
+#endif  // TINYCLANG_SOURCE_LINESCANNER_H
\ No newline at end of file
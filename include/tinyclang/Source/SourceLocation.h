@@ -3,30 +3,32 @@
 
 namespace tinyclang {
 
+/// SourceLocation - This is a carefully crafted 32-bit identifier that encodes
+/// a position in the source.  There are two kinds:
+///
+/// File locations have the high bit clear.  The SourceManager lays every
+/// FileID it creates end to end in one offset space, each owning a contiguous
+/// range of it, and a file location is simply an offset in that space.  Offset
+/// 0 is never handed out, so it serves as the invalid location.
+///
+/// Macro locations have the high bit set.  The rest is an index into the
+/// SourceManager's table of tokens produced by macro expansion, which records
+/// where each was spelled and where its macro was expanded.
+///
+/// Only the SourceManager can map a SourceLocation back to a FileID and file
+/// position.
 class SourceLocation {
+  friend class SourceManager;
+
+  enum : unsigned { MacroIDBit = 1U << 31 };
+
  public:
-  enum { FileIDBits = 12, FilePosBits = 32 - FileIDBits };
-
-  SourceLocation() : ID(0) {}  // 0 is an invalid FileID.
-
-  /// SourceLocation constructor - Create a new SourceLocation object with the
-  /// specified FileID and FilePos.
-  SourceLocation(unsigned file_id, unsigned file_pos) {
-    // If a FilePos is larger than (1<<FilePosBits), the SourceManager makes
-    // enough consequtive FileIDs that we have one for each chunk.
-    if (file_pos >= (1 << FilePosBits)) {
-      file_id += file_pos >> FilePosBits;
-      file_pos &= (1 << FilePosBits) - 1;
-    }
-
-    // FIXME: Find a way to handle out of FileID bits!  Maybe MaxFileID is an
-    // escape of some sort?
-    if (file_id >= (1 << FileIDBits)) {
-      file_id = (1 << FileIDBits) - 1;
-    }
-
-    ID = (file_id << FilePosBits) | file_pos;
-  }
+  SourceLocation() : ID(0) {}  // 0 is an invalid offset.
+
+  /// isFileID/isMacroID - Return true if this is a file location, or one
+  /// produced by a macro expansion.
+  bool isFileID() const { return (ID & MacroIDBit) == 0; }
+  bool isMacroID() const { return (ID & MacroIDBit) != 0; }
 
   /// isValid - Return true if this is a valid SourceLocation object.  Invalid
   /// SourceLocations are often used when events have no corresponding location
@@ -34,16 +36,12 @@ class SourceLocation {
   ///
   bool isValid() const { return ID != 0; }
 
-  /// getFileID - Return the file identifier for this SourceLocation.  This
-  /// FileID can be used with the SourceManager object to obtain an entire
-  /// include stack for a file position reference.
-  unsigned getFileID() const { return ID >> FilePosBits; }
-
-  /// getRawFilePos - Return the byte offset from the start of the file-chunk
-  /// referred to by FileID.  This method should not be used to get the offset
-  /// from the start of the file, instead you should use
-  /// SourceManager::getFilePos.  This method will be incorrect for large files.
-  unsigned getRawFilePos() const { return ID & ((1 << FilePosBits) - 1); }
+  /// getLocWithOffset - Return a source location with the specified offset
+  /// from this SourceLocation.  The result must stay within the same FileID,
+  /// or the same macro expansion.
+  SourceLocation getLocWithOffset(int offset) const {
+    return getFromRawEncoding(ID + offset);
+  }
 
   /// getRawEncoding - When a SourceLocation itself cannot be used, this returns
   /// an (opaque) 32-bit integer encoding for it.  This should only be passed
@@ -60,6 +58,14 @@ class SourceLocation {
   }
 
  private:
+  /// getOffset - The position in the SourceManager's offset space, or in its
+  /// table of macro locations.
+  unsigned getOffset() const { return ID & ~MacroIDBit; }
+
+  static SourceLocation getMacroLoc(unsigned index) {
+    return getFromRawEncoding(index | MacroIDBit);
+  }
+
   unsigned ID;
 };
 
@@ -4,6 +4,8 @@
 #include <cassert>
 #include <list>
 #include <map>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "llvm/Support/MemoryBuffer.h"
@@ -15,6 +17,16 @@ class SourceManager;
 class FileEntry;
 class IdentifierTokenInfo;
 
+/// BufferLoadPolicy - How the SourceManager brings the contents of a file into
+/// memory.  Mapping avoids a copy, but costs a system call and page faults
+/// that make it slower than read() for the small headers that are the bulk of
+/// most translation units.
+enum class BufferLoadPolicy {
+  Threshold,   // Map files of at least the mmap threshold, read the rest.
+  AlwaysMap,   // Map every non-empty file.
+  AlwaysRead,  // Read every file into a heap buffer.
+};
+
 /// SourceManager - This file handles loading and caching of source files into
 /// memory.  This object owns the SourceBuffer objects for all of the loaded
 /// files and assigns unique FileID's for each unique #include chain.
@@ -34,6 +46,10 @@ class SourceManager {
     /// NumLines - The number of lines in this FileInfo.  This is only valid if
     /// SourceLineCache is non-null.
     unsigned NumLines;
+
+    /// LastLineNo - The line number the last line lookup in this file landed
+    /// on.  This is only valid if SourceLineCache is non-null.
+    unsigned LastLineNo;
   };
 
   using InfoRec = std::pair<const FileEntry* const, FileInfo>;
@@ -42,20 +58,28 @@ class SourceManager {
   /// represents and include stack information.
   struct FileIDInfo {
     /// IncludeLoc - The location of the #include that brought in this file.
-    /// This SourceLocation object has a FileId of 0 for the main file.
+    /// This is an invalid SourceLocation for the main file.
     SourceLocation IncludeLoc;
 
-    /// ChunkNo - Really large files are broken up into chunks that are each
-    /// (1 << SourceLocation::FilePosBits) in size.  This specifies the chunk
-    /// number of this FileID.
-    unsigned ChunkNo;
+    /// StartOffset - The first offset of the range this FileID owns in the
+    /// SourceLocation offset space.  The range ends where the next FileID's
+    /// starts.
+    unsigned StartOffset;
 
     /// FileInfo - Information about the file itself.
     ///
     const InfoRec* Info;
 
-    FileIDInfo(SourceLocation il, unsigned cn, const InfoRec* inf)
-        : IncludeLoc(il), ChunkNo(cn), Info(inf) {}
+    FileIDInfo(SourceLocation il, unsigned so, const InfoRec* inf)
+        : IncludeLoc(il), StartOffset(so), Info(inf) {}
+  };
+
+  /// MacroLocInfo - The two locations behind each macro location: where the
+  /// token was spelled, and where the macro that produced it was expanded.
+  /// The latter is itself a macro location for nested expansions.
+  struct MacroLocInfo {
+    SourceLocation SpellingLoc;
+    SourceLocation ExpansionLoc;
   };
 
   /// FileInfos - Memoized information about all of the files tracked by this
@@ -68,12 +92,54 @@ class SourceManager {
   std::list<InfoRec> MemBufferInfos;
 
   /// FileIDs - Information about each FileID.  FileID #0 is not valid, so all
-  /// entries are off by one.
+  /// entries are off by one.  The StartOffsets are increasing.
   std::vector<FileIDInfo> FileIDs;
 
+  /// NextOffset - The start of the unallocated part of the offset space.
+  /// Offset 0 is the invalid SourceLocation.
+  unsigned NextOffset = 1;
+
+  /// MacroLocs - The macro location table, indexed by SourceLocation::getOffset
+  /// of a macro location.  Each expansion takes a block of consecutive entries,
+  /// one per token it produces.
+  std::vector<MacroLocInfo> MacroLocs;
+
+  /// LastLookupFileID - The FileID that the last getFileID call found.  Most
+  /// lookups are for the file being lexed, so this avoids the search.
+  mutable unsigned LastLookupFileID = 0;
+
+  /// Statistics for FileID lookups.
+  mutable unsigned NumFileIDLookups = 0;
+  mutable unsigned NumFileIDSearches = 0;
+
+  /// LoadPolicy/MapThreshold - How file buffers are loaded, see
+  /// setBufferLoadPolicy.
+  BufferLoadPolicy LoadPolicy = BufferLoadPolicy::Threshold;
+  unsigned MapThreshold = DefaultMapThreshold;
+
+  /// Statistics for file loading.
+  unsigned NumFilesMapped = 0, NumBytesMapped = 0;
+  unsigned NumFilesRead = 0, NumBytesRead = 0;
+
+  /// Statistics for line number lookups.
+  mutable unsigned NumLineLookups = 0;
+  mutable unsigned NumLineCacheHits = 0;
+
  public:
+  /// DefaultMapThreshold - Files at least this big are mapped under the
+  /// Threshold policy.
+  enum { DefaultMapThreshold = 16 * 1024 };
+
   ~SourceManager();
 
+  /// setBufferLoadPolicy - Set how files loaded after this call are brought
+  /// into memory.  'map_threshold' is only used by the Threshold policy.
+  void setBufferLoadPolicy(BufferLoadPolicy policy,
+                           unsigned map_threshold = DefaultMapThreshold) {
+    LoadPolicy = policy;
+    MapThreshold = map_threshold;
+  }
+
   /// createFileID - Create a new FileID that represents the specified file
   /// being #included from the specified IncludePosition.  This returns 0 on
   /// error and translates NULL into standard input.
@@ -94,13 +160,56 @@ class SourceManager {
     return createFileID(ir, SourceLocation());
   }
 
-  /// getMacroID - Get or create a new FileID that represents a macro with the
-  /// specified identifier being expanded at the specified position.  This can
-  /// never fail.
-  unsigned getMacroID(const IdentifierTokenInfo* identifier,
-                      SourceLocation expand_pos) {
-    // FIXME: Implement ID's for macro expansions!
-    return expand_pos.getFileID();
+  /// createExpansionLocs - Allocate a macro location for each of the num_locs
+  /// tokens produced by expanding a macro at expansion_loc, and return the
+  /// first.  The location of token #i is getLocWithOffset(i) from it.  Each
+  /// location's spelling must be set with setSpellingLoc before it is handed
+  /// out.  This can never fail.
+  SourceLocation createExpansionLocs(SourceLocation expansion_loc,
+                                     unsigned num_locs) {
+    unsigned first = MacroLocs.size();
+    assert(first + num_locs < SourceLocation::MacroIDBit &&
+           "Ran out of macro locations!");
+    MacroLocs.resize(first + num_locs,
+                     MacroLocInfo{SourceLocation(), expansion_loc});
+    return SourceLocation::getMacroLoc(first);
+  }
+
+  /// setSpellingLoc - Record where the token with the specified macro location
+  /// was spelled.
+  void setSpellingLoc(SourceLocation macro_loc, SourceLocation spelling_loc) {
+    assert(macro_loc.isMacroID() && spelling_loc.isFileID() &&
+           "Invalid spelling location for a macro token!");
+    MacroLocs[macro_loc.getOffset()].SpellingLoc = spelling_loc;
+  }
+
+  /// createExpansionLoc - Create the macro location of a single token spelled
+  /// at spelling_loc, produced by expanding a macro at expansion_loc.
+  SourceLocation createExpansionLoc(SourceLocation spelling_loc,
+                                    SourceLocation expansion_loc) {
+    SourceLocation loc = createExpansionLocs(expansion_loc, 1);
+    setSpellingLoc(loc, spelling_loc);
+    return loc;
+  }
+
+  /// getSpellingLoc - Return the file location where the characters of the
+  /// token at the specified location were written.  For a file location this
+  /// is the location itself.
+  SourceLocation getSpellingLoc(SourceLocation loc) const {
+    if (loc.isFileID()) {
+      return loc;
+    }
+    return MacroLocs[loc.getOffset()].SpellingLoc;
+  }
+
+  /// getExpansionLoc - Return the file location of the outermost macro name
+  /// that the token at the specified location was expanded from.  For a file
+  /// location this is the location itself.
+  SourceLocation getExpansionLoc(SourceLocation loc) const {
+    while (loc.isMacroID()) {
+      loc = MacroLocs[loc.getOffset()].ExpansionLoc;
+    }
+    return loc;
   }
 
   /// getBuffer - Return the buffer for the specified FileID.
@@ -116,26 +225,59 @@ class SourceManager {
     return FileIDs[file_id - 1].IncludeLoc;
   }
 
+  /// getFileID - Return the FileID whose range contains the specified
+  /// SourceLocation, or 0 for an invalid one.  The FileID implicitly encodes
+  /// the include stack of the position.  Macro locations are looked up by
+  /// their expansion location, as are the file positions, line numbers and
+  /// column numbers below.
+  unsigned getFileID(SourceLocation loc) const {
+    ++NumFileIDLookups;
+    loc = getExpansionLoc(loc);
+    if (!loc.isValid()) {
+      return 0;
+    }
+    if (LastLookupFileID != 0 && isOffsetInFileID(loc.getOffset(),
+                                                  LastLookupFileID)) {
+      return LastLookupFileID;
+    }
+    return getFileIDSlow(loc.getOffset());
+  }
+
+  /// getLocForStartOfFile - Return the SourceLocation of the first character
+  /// of the specified FileID.  Other positions in the file are at an offset
+  /// from it.
+  SourceLocation getLocForStartOfFile(unsigned file_id) const {
+    assert(file_id - 1 < FileIDs.size() && "Invalid FileID!");
+    return SourceLocation::getFromRawEncoding(FileIDs[file_id - 1].StartOffset);
+  }
+
   /// getFilePos - This (efficient) method returns the offset from the start of
   /// the file that the specified SourceLocation represents.
-  unsigned getFilePos(SourceLocation include_pos) const {
-    assert(include_pos.getFileID() - 1 < FileIDs.size() && "Invalid FileID!");
-    // If this file has been split up into chunks, factor in the chunk number
-    // that the FileID references.
-    unsigned chunk_no = FileIDs[include_pos.getFileID() - 1].ChunkNo;
-    return include_pos.getRawFilePos() +
-           (chunk_no << SourceLocation::FilePosBits);
+  unsigned getFilePos(SourceLocation loc) const {
+    return getDecomposedLoc(loc).second;
+  }
+
+  /// getCharacterData - Return a pointer to the first character of the token
+  /// at the specified location.  For a macro location this is where the token
+  /// was spelled, not where the macro was expanded.
+  auto getCharacterData(SourceLocation loc) const -> const char* {
+    loc = getSpellingLoc(loc);
+    unsigned file_id = getFileID(loc);
+    assert(file_id - 1 < FileIDs.size() && "Invalid FileID!");
+    const FileIDInfo& info = FileIDs[file_id - 1];
+    return info.Info->second.Buffer->getBufferStart() +
+           (loc.getOffset() - info.StartOffset);
   }
 
   /// getColumnNumber - Return the column # for the specified include position.
-  /// this is significantly cheaper to compute than the line number.  This
-  /// returns zero if the column number isn't known.
+  /// This uses the same line table as getLineNumber.  This returns zero if the
+  /// column number isn't known.
   unsigned getColumnNumber(SourceLocation include_pos) const;
 
   /// getLineNumber - Given a SourceLocation, return the physical line number
   /// for the position indicated.  This requires building and caching a table of
-  /// line offsets for the SourceBuffer, so this is not cheap: use only when
-  /// about to emit a diagnostic.
+  /// line offsets for the SourceBuffer, so the first query of each file is not
+  /// cheap.  Later queries at or just after the previous one are O(1).
   unsigned getLineNumber(SourceLocation include_pos);
 
   /// getFileEntryForFileID - Return the FileEntry record for the specified
@@ -152,9 +294,32 @@ class SourceManager {
  private:
   /// createFileID - Create a new fileID for the specified InfoRec and include
   /// position.  This works regardless of whether the InfoRec corresponds to a
-  /// file or some other input source.
+  /// file or some other input source.  This returns 0 if the offset space is
+  /// exhausted.
   unsigned createFileID(const InfoRec* file, SourceLocation include_pos);
 
+  /// isOffsetInFileID - Return true if the specified offset is in the range
+  /// owned by the specified FileID.
+  bool isOffsetInFileID(unsigned offset, unsigned file_id) const {
+    unsigned end = file_id < FileIDs.size() ? FileIDs[file_id].StartOffset
+                                            : NextOffset;
+    return offset >= FileIDs[file_id - 1].StartOffset && offset < end;
+  }
+
+  /// getDecomposedLoc - Return the FileID and file position of the specified
+  /// location.
+  auto getDecomposedLoc(SourceLocation loc) const
+      -> std::pair<unsigned, unsigned> {
+    loc = getExpansionLoc(loc);
+    unsigned file_id = getFileID(loc);
+    assert(file_id - 1 < FileIDs.size() && "Invalid FileID!");
+    return {file_id, loc.getOffset() - FileIDs[file_id - 1].StartOffset};
+  }
+
+  /// getFileIDSlow - Binary search the FileIDs for the one owning the
+  /// specified offset, and remember it for the next lookup.
+  unsigned getFileIDSlow(unsigned offset) const;
+
   /// getFileInfo - Create or return a cached FileInfo for the specified file.
   /// This returns null on failure.
   const InfoRec* getInfoRec(const FileEntry* file_ent);
@@ -163,6 +328,19 @@ class SourceManager {
   /// buffer.  This does no caching.
   const InfoRec* createMemBufferInfoRec(const llvm::MemoryBuffer* buffer);
 
+  /// loadFileBuffer - Map or read the specified file according to the load
+  /// policy.  The returned buffer is null terminated and owned by the caller.
+  /// This returns null on failure.
+  auto loadFileBuffer(const FileEntry* file_ent)
+      -> std::unique_ptr<llvm::MemoryBuffer>;
+
+  /// computeLineTable - Build the SourceLineCache of the specified file.
+  void computeLineTable(FileInfo* file_info);
+
+  /// findLineNumber - Return the 1-based physical line number that the
+  /// specified offset of the file lands on, building the line table if needed.
+  unsigned findLineNumber(FileInfo* file_info, unsigned file_pos) const;
+
   const InfoRec* getInfoRec(unsigned file_id) const {
     assert(file_id - 1 < FileIDs.size() && "Invalid FileID!");
     return FileIDs[file_id - 1].Info;
@@ -1,33 +1,77 @@
 #include "tinyclang/Basic/FileManager.h"
 
+#include <dirent.h>
 #include <sys/stat.h>
 
 #include <iostream>
 
 namespace tinyclang {
 
-/// getDirectory - Lookup, cache, and verify the specified directory.  This
+/// isMissingFromDirectory - Return true if the listing of the specified
+/// directory is available and doesn't contain name.  The listing is read on
+/// first use.
+auto FileManager::isMissingFromDirectory(DirectoryEntry& dir,
+                                         llvm::StringRef name) -> bool {
+  if (dir.ContentsState == DirectoryEntry::ContentsNotRead) {
+    DIR* dir_stream = opendir(dir.Name.c_str());
+    if (dir_stream == nullptr) {
+      // Can't read it (e.g. search permission only), fall back to stat'ing.
+      dir.ContentsState = DirectoryEntry::ContentsUnavailable;
+      return false;
+    }
+
+    ++NumDirListingsRead;
+    while (struct dirent* ent = readdir(dir_stream)) {
+      dir.Contents.insert(ent->d_name);
+    }
+    closedir(dir_stream);
+    dir.ContentsState = DirectoryEntry::ContentsRead;
+  }
+
+  return dir.ContentsState == DirectoryEntry::ContentsRead &&
+         !dir.Contents.contains(name);
+}
+
+/// getDirectoryEntry - Lookup, cache, and verify the specified directory.  This
 /// returns null if the directory doesn't exist.
-auto FileManager::getDirectory(const std::string& filename)
-    -> const DirectoryEntry* {
+auto FileManager::getDirectoryEntry(llvm::StringRef filename)
+    -> DirectoryEntry* {
   ++NumDirLookups;
-  // See if there is already an entry in the map.
-  auto i = DirEntries.lower_bound(filename);
-  if (i != DirEntries.end() && i->first == filename) {
-    return i->second;
+  // See if there is already an entry in the map.  This is a single hashed
+  // probe: either we find the cached answer, or we reserve (and zero
+  // initialize) the slot that will hold it.
+  auto inserted = DirEntries.try_emplace(filename, nullptr);
+  DirectoryEntry*& ent = inserted.first->second;
+  if (!inserted.second) {
+    return ent;
   }
 
   ++NumDirCacheMisses;
 
-  // By default, zero initialize it.
-  DirectoryEntry*& ent =
-      DirEntries.insert(i, std::make_pair(filename, (DirectoryEntry*)nullptr))
-          ->second;
+  // The interned key is null terminated, so it can be handed to stat directly.
+  const char* interned_name = inserted.first->getKeyData();
+
+  // If we already know the parent directory, and it has no entry with this
+  // name, don't bother stat'ing.  This handles #include <sys/foo.h> in search
+  // directories that have no sys/ subdirectory.
+  if (CacheDirListings) {
+    llvm::StringRef::size_type slash_pos = filename.rfind('/');
+    if (slash_pos != llvm::StringRef::npos && slash_pos != 0 &&
+        slash_pos != filename.size() - 1) {
+      auto parent = DirEntries.find(filename.substr(0, slash_pos));
+      if (parent != DirEntries.end() && parent->second &&
+          isMissingFromDirectory(*parent->second,
+                                 filename.substr(slash_pos + 1))) {
+        ++NumStatsAvoided;
+        return nullptr;
+      }
+    }
+  }
 
   // Nope, there isn't.  Check to see if the directory exists.
   struct stat stat_buf;
-  if (stat(filename.c_str(), &stat_buf) ||  // Error stat'ing.
-      !S_ISDIR(stat_buf.st_mode)) {         // Not a directory?
+  if (stat(interned_name, &stat_buf) ||  // Error stat'ing.
+      !S_ISDIR(stat_buf.st_mode)) {      // Not a directory?
     return nullptr;
   }
 
@@ -42,56 +86,62 @@ auto FileManager::getDirectory(const std::string& filename)
   }
 
   // Otherwise, we don't have this directory yet, add it.
-  auto* de = new DirectoryEntry();
-  de->Name = filename;
+  auto* de = new (DirEntryAlloc.Allocate()) DirectoryEntry();
+  de->Name = interned_name;
   return ent = ude = de;
 }
 
 /// getFile - Lookup, cache, and verify the specified file.  This returns null
 /// if the file doesn't exist.
-auto FileManager::getFile(const std::string& filename) -> const FileEntry* {
+auto FileManager::getFile(llvm::StringRef filename) -> const FileEntry* {
   ++NumFileLookups;
 
-  // See if there is already an entry in the map.
-  auto i = FileEntries.lower_bound(filename);
-  if (i != FileEntries.end() && i->first == filename) {
-    return i->second;
+  // See if there is already an entry in the map.  If not, this reserves a zero
+  // initialized slot for it.
+  auto inserted = FileEntries.try_emplace(filename, nullptr);
+  FileEntry*& ent = inserted.first->second;
+  if (!inserted.second) {
+    return ent;
   }
 
   ++NumFileCacheMisses;
 
-  // By default, zero initialize it.
-  FileEntry*& ent =
-      FileEntries.insert(i, std::make_pair(filename, (FileEntry*)nullptr))
-          ->second;
+  // The interned key is null terminated, so it can be handed to stat directly.
+  const char* interned_name = inserted.first->getKeyData();
 
-  // Figure out what directory it is in.
-  std::string dir_name;
+  // Figure out what directory it is in, and the name of the file within it.
+  llvm::StringRef dir_name;
+  llvm::StringRef base_name = filename;
 
   // If the string contains a / in it, strip off everything after it.
   // FIXME: this logic should be in sys::Path.
-  std::string::size_type slash_pos = filename.find_last_of('/');
-  if (slash_pos == std::string::npos) {
+  llvm::StringRef::size_type slash_pos = filename.rfind('/');
+  if (slash_pos == llvm::StringRef::npos) {
     dir_name = ".";  // Use the current directory if file has no path component.
   } else if (slash_pos == filename.size() - 1) {
     return nullptr;  // If filename ends with a /, it's a directory.
   } else {
-    dir_name = std::string(filename.begin(), filename.begin() + slash_pos);
+    dir_name = filename.substr(0, slash_pos);
+    base_name = filename.substr(slash_pos + 1);
   }
 
-  const DirectoryEntry* dir_info = getDirectory(dir_name);
+  DirectoryEntry* dir_info = getDirectoryEntry(dir_name);
   if (dir_info == nullptr) {  // Directory doesn't exist, file can't exist.
     return nullptr;
   }
 
-  // FIXME: Use the directory info to prune this, before doing the stat syscall.
-  // FIXME: This will reduce the # syscalls.
+  // Use the directory info to prune this, before doing the stat syscall.  For
+  // an #include searched across many directories, most probes end here.
+  if (CacheDirListings && isMissingFromDirectory(*dir_info, base_name)) {
+    ++NumStatsAvoided;
+    return nullptr;
+  }
 
   // Nope, there isn't.  Check to see if the file exists.
   struct stat stat_buf;
   // std::cerr << "STATING: " << Filename;
-  if (stat(filename.c_str(), &stat_buf) ||  // Error stat'ing.
-      S_ISDIR(stat_buf.st_mode)) {          // A directory?
+  if (stat(interned_name, &stat_buf) ||  // Error stat'ing.
+      S_ISDIR(stat_buf.st_mode)) {       // A directory?
     // If this file doesn't exist, we leave a null in FileEntries for this path.
     // std::cerr << ": Not existing\n";
     return nullptr;
@@ -108,8 +158,8 @@ auto FileManager::getFile(const std::string& filename) -> const FileEntry* {
   }
 
   // Otherwise, we don't have this directory yet, add it.
-  auto* fe = new FileEntry();
-  fe->Name = filename;
+  auto* fe = new (FileEntryAlloc.Allocate()) FileEntry();
+  fe->Name = interned_name;
   fe->Size = stat_buf.st_size;
   fe->ModTime = stat_buf.st_mtime;
   fe->Dir = dir_info;
@@ -125,6 +175,13 @@ void FileManager::PrintStats() const {
             << " dir cache misses.\n";
   std::cerr << NumFileLookups << " file lookups, " << NumFileCacheMisses
             << " file cache misses.\n";
+  if (CacheDirListings) {
+    std::cerr << NumDirListingsRead << " dir listings read, "
+              << NumStatsAvoided << " stat calls avoided.\n";
+  }
+  std::cerr << DirEntries.getAllocator().getTotalMemory() +
+                   FileEntries.getAllocator().getTotalMemory()
+            << " bytes of interned path names.\n";
 
   // std::cerr << PagesMapped << BytesOfPagesMapped << FSLookups;
 }
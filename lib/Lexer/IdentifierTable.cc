@@ -3,16 +3,10 @@
 #include <cstring>
 #include <iostream>
 
-#include "tinyclang/Lexer/MacroInfo.h"
+#include "tinyclang/Lexer/Lexer.h"
 
 namespace tinyclang {
 
-//===----------------------------------------------------------------------===//
-// IdentifierTokenInfo Implementation
-//===----------------------------------------------------------------------===//
-
-void IdentifierTokenInfo::Destroy() { delete Macro; }
-
 //===----------------------------------------------------------------------===//
 // Memory Allocation Support
 //===----------------------------------------------------------------------===//
@@ -87,107 +81,285 @@ class MemRegion {
 #endif
 
 //===----------------------------------------------------------------------===//
-// IdentifierTable Implementation
+// Keyword Recognition
 //===----------------------------------------------------------------------===//
 
-/// IdentifierLink - There is one of these allocated by IdentifierTokenInfo.
-/// These form the linked list of buckets for the hash table.
-struct IdentifierBucket {
-  /// Next - This is the next bucket in the linked list.
-  IdentifierBucket* Next;
+namespace {
+
+/// The KEYWORD flags in TokenKind.def.  Each language has a two-bit field: 0 if
+/// the keyword is enabled in it, 1 if it is an extension, 2 if it is disabled.
+enum {
+  C90Shift = 0,
+  EXTC90 = 1 << C90Shift,
+  NOTC90 = 2 << C90Shift,
+  C99Shift = 2,
+  EXTC99 = 1 << C99Shift,
+  NOTC99 = 2 << C99Shift,
+  CPPShift = 4,
+  EXTCPP = 1 << CPPShift,
+  NOTCPP = 2 << CPPShift,
+  LangMask = 3
+};
+
+/// KeywordInfo - A keyword, alias or directive name from TokenKind.def.  "if"
+/// and "else" are both keywords and directive names, and have one entry.
+struct KeywordInfo {
+  const char* Name = 0;
+  unsigned Length = 0;
+  unsigned FullHash = 0;
+  tok::TokenKind TokenID = tok::identifier;  // identifier if not a keyword.
+  tok::PPKeywordKind PPKeywordID = tok::pp_not_keyword;
+  unsigned char Flags = 0;
+};
 
-  IdentifierTokenInfo TokInfo;
-  // NOTE: TokInfo must be the last element in this structure, as the string
-  // information for the identifier is allocated right after it.
+/// MaxKeywords - The number of names in TokenKind.def, counting the ones that
+/// are both keywords and directive names twice.
+enum {
+  MaxKeywords = 0
+#define KEYWORD(NAME, FLAGS) +1
+#define ALIAS(NAME, TOK) +1
+#define PPKEYWORD(NAME) +1
+#include "tinyclang/Lexer/TokenKind.def"
 };
 
-// FIXME: start hashtablesize off at 8K entries, GROW when density gets to 3.
-static unsigned HASH_TABLE_SIZE = 8096;
+struct KeywordList {
+  KeywordInfo Keywords[MaxKeywords];
+  unsigned NumKeywords = 0;
+
+  constexpr void Add(const char* Name, tok::TokenKind TokenID,
+                     tok::PPKeywordKind PPKeywordID, unsigned Flags) {
+    unsigned Length = 0;
+    while (Name[Length])
+      ++Length;
+
+    // A directive name may already be in the list as a keyword.
+    for (unsigned i = 0; i != NumKeywords; ++i) {
+      KeywordInfo& KW = Keywords[i];
+      if (KW.Length != Length)
+        continue;
+      unsigned j = 0;
+      while (j != Length && KW.Name[j] == Name[j])
+        ++j;
+      if (j == Length) {
+        KW.PPKeywordID = PPKeywordID;
+        return;
+      }
+    }
+
+    KeywordInfo& KW = Keywords[NumKeywords++];
+    KW.Name = Name;
+    KW.Length = Length;
+    KW.FullHash = IdentifierTable::HashString(Name, Name + Length);
+    KW.TokenID = TokenID;
+    KW.PPKeywordID = PPKeywordID;
+    KW.Flags = Flags;
+  }
+};
 
-IdentifierTable::IdentifierTable() {
-  IdentifierBucket** TableArray = new IdentifierBucket*[HASH_TABLE_SIZE]();
-  TheTable = TableArray;
+constexpr KeywordList BuildKeywordList() {
+  KeywordList List;
+#define KEYWORD(NAME, FLAGS) \
+  List.Add(#NAME, tok::kw_##NAME, tok::pp_not_keyword, FLAGS);
+#define ALIAS(NAME, TOK) List.Add(NAME, tok::kw_##TOK, tok::pp_not_keyword, 0);
+#define PPKEYWORD(NAME) List.Add(#NAME, tok::identifier, tok::pp_##NAME, 0);
+#include "tinyclang/Lexer/TokenKind.def"
+  return List;
+}
+
+constexpr KeywordList Keywords = BuildKeywordList();
+static_assert(Keywords.NumKeywords < 256, "KeywordTable entries are a byte");
+
+/// KeywordTable - A perfect hash of the keywords, searched for at compile time.
+/// A name's slot is the top KeywordTableBits bits of its FullHash times the
+/// multiplier, which is picked so that no two keywords share a slot.  Looking
+/// up a name is then one multiply, one load and one string compare, and since
+/// FullHash is what the identifier table hashes by anyway, it is free.
+enum { KeywordTableBits = 11, KeywordTableSize = 1 << KeywordTableBits };
+
+struct KeywordTable {
+  unsigned Multiplier = 0;  // Zero if no multiplier was found.
+  unsigned char Slots[KeywordTableSize] = {};  // 1 + index in Keywords, or 0.
+
+  constexpr unsigned getSlot(unsigned FullHash) const {
+    return (FullHash * Multiplier) >> (32 - KeywordTableBits);
+  }
+};
+
+constexpr KeywordTable BuildKeywordTable() {
+  KeywordTable Table;
+  // Try odd multipliers starting at 2^32/phi until one has no collisions.
+  for (unsigned Try = 0; Try != 4096; ++Try) {
+    Table.Multiplier = 0x9e3779b1 + 2 * Try;
+    for (unsigned i = 0; i != KeywordTableSize; ++i)
+      Table.Slots[i] = 0;
+
+    unsigned i = 0;
+    for (; i != Keywords.NumKeywords; ++i) {
+      unsigned char& Slot =
+          Table.Slots[Table.getSlot(Keywords.Keywords[i].FullHash)];
+      if (Slot)
+        break;
+      Slot = i + 1;
+    }
+    if (i == Keywords.NumKeywords)
+      return Table;
+  }
+  Table.Multiplier = 0;
+  return Table;
+}
+
+constexpr KeywordTable TheKeywordTable = BuildKeywordTable();
+static_assert(TheKeywordTable.Multiplier != 0,
+              "no perfect hash for the keywords, grow KeywordTableBits");
+
+/// LookupKeyword - Return the keyword entry for the specified name, or null.
+inline const KeywordInfo* LookupKeyword(const char* NameStart, unsigned Length,
+                                        unsigned FullHash) {
+  unsigned Idx = TheKeywordTable.Slots[TheKeywordTable.getSlot(FullHash)];
+  if (Idx == 0)
+    return 0;
+  const KeywordInfo& KW = Keywords.Keywords[Idx - 1];
+  if (KW.FullHash != FullHash || KW.Length != Length ||
+      memcmp(KW.Name, NameStart, Length) != 0)
+    return 0;
+  return &KW;
+}
+
+}  // namespace
+
+tok::PPKeywordKind IdentifierTable::getPPKeywordID(const char* NameStart,
+                                                   const char* NameEnd) {
+  const KeywordInfo* KW = LookupKeyword(NameStart, NameEnd - NameStart,
+                                        HashString(NameStart, NameEnd));
+  return KW ? KW->PPKeywordID : tok::pp_not_keyword;
+}
+
+//===----------------------------------------------------------------------===//
+// IdentifierTable Implementation
+//===----------------------------------------------------------------------===//
+
+/// IdentifierSlot - The hash table is open addressed with linear probing.
+/// Each slot caches the full hash of its identifier, so probing only touches
+/// the identifier itself when the hashes match, and growing the table never
+/// rehashes a string.
+struct IdentifierSlot {
+  unsigned FullHash;
+  IdentifierTokenInfo* Info;  // Null if the slot is empty.
+};
+
+/// InitialTableSize - Start with 8K slots, enough for the predefined macros and
+/// keywords and a small translation unit.  This must be a power of two.
+static const unsigned InitialTableSize = 8192;
+
+IdentifierTable::IdentifierTable(const LangOptions& LangOpts) {
+  KeywordLangShift = LangOpts.CPlusPlus ? CPPShift
+                     : LangOpts.C99     ? C99Shift
+                                        : C90Shift;
+  NoExtensions = LangOpts.NoExtensions;
+
+  TableSize = InitialTableSize;
+  TheTable = new IdentifierSlot[TableSize]();
   NumIdentifiers = 0;
+  NumGrows = 0;
 #if USE_ALLOCATOR
   TheMemory = malloc(8 * 4096);
   ((MemRegion*)TheMemory)->Init(8 * 4096, 0);
 #endif
-
-  memset(TheTable, 0, HASH_TABLE_SIZE * sizeof(IdentifierBucket*));
 }
 
 IdentifierTable::~IdentifierTable() {
-  IdentifierBucket** TableArray = (IdentifierBucket**)TheTable;
-  for (unsigned i = 0, e = HASH_TABLE_SIZE; i != e; ++i) {
-    IdentifierBucket* Id = TableArray[i];
-    while (Id) {
-      // Free memory referenced by the identifier (e.g. macro info).
-      Id->TokInfo.Destroy();
-
-      IdentifierBucket* Next = Id->Next;
-#if !USE_ALLOCATOR
-      free(Id);
-#endif
-      Id = Next;
-    }
-  }
+  // Identifiers own nothing: their macros live in the Preprocessor's arena.
+  IdentifierSlot* Table = (IdentifierSlot*)TheTable;
 #if USE_ALLOCATOR
   ((MemRegion*)TheMemory)->Deallocate();
+#else
+  for (unsigned i = 0, e = TableSize; i != e; ++i)
+    free(Table[i].Info);
 #endif
-  delete[] TableArray;
+  delete[] Table;
 }
 
-/// HashString - Compute a hash code for the specified string.
-///
-static unsigned HashString(const char* Start, const char* End) {
-  unsigned int Result = 0;
-  // Perl hash function.
-  while (Start != End)
-    Result = Result * 33 + *Start++;
-  Result = Result + (Result >> 5);
-  return Result;
+/// Grow - Double the size of the table, moving every identifier to its slot in
+/// the new table by its cached hash.
+void IdentifierTable::Grow() {
+  IdentifierSlot* OldTable = (IdentifierSlot*)TheTable;
+  unsigned OldSize = TableSize;
+
+  TableSize = OldSize * 2;
+  IdentifierSlot* NewTable = new IdentifierSlot[TableSize]();
+  unsigned Mask = TableSize - 1;
+  for (unsigned i = 0; i != OldSize; ++i) {
+    if (OldTable[i].Info == 0)
+      continue;
+    unsigned Idx = OldTable[i].FullHash & Mask;
+    while (NewTable[Idx].Info)
+      Idx = (Idx + 1) & Mask;
+    NewTable[Idx] = OldTable[i];
+  }
+
+  delete[] OldTable;
+  TheTable = NewTable;
+  ++NumGrows;
 }
 
 IdentifierTokenInfo& IdentifierTable::get(const char* NameStart,
-                                          const char* NameEnd) {
-  IdentifierBucket** TableArray = (IdentifierBucket**)TheTable;
+                                          const char* NameEnd,
+                                          unsigned FullHash) {
+  IdentifierSlot* Table = (IdentifierSlot*)TheTable;
 
-  unsigned Hash = HashString(NameStart, NameEnd) % HASH_TABLE_SIZE;
   unsigned Length = NameEnd - NameStart;
-
-  IdentifierBucket* IdentHead = TableArray[Hash];
-  for (IdentifierBucket* Identifier = IdentHead; Identifier;
-       Identifier = Identifier->Next) {
-    if (Identifier->TokInfo.getNameLength() == Length &&
-        memcmp(Identifier->TokInfo.getName(), NameStart, Length) == 0)
-      return Identifier->TokInfo;
+  unsigned Mask = TableSize - 1;
+
+  unsigned Idx = FullHash & Mask;
+  for (; Table[Idx].Info; Idx = (Idx + 1) & Mask) {
+    IdentifierTokenInfo* Identifier = Table[Idx].Info;
+    if (Table[Idx].FullHash == FullHash &&
+        Identifier->getNameLength() == Length &&
+        memcmp(Identifier->getName(), NameStart, Length) == 0)
+      return *Identifier;
   }
 
   // Allocate a new identifier, with space for the null-terminated string at the
   // end.
-  unsigned AllocSize = sizeof(IdentifierBucket) + Length + 1;
+  unsigned AllocSize = sizeof(IdentifierTokenInfo) + Length + 1;
 #if USE_ALLOCATOR
-  IdentifierBucket* Identifier =
-      (IdentifierBucket*)((MemRegion*)TheMemory)
+  IdentifierTokenInfo* Identifier =
+      (IdentifierTokenInfo*)((MemRegion*)TheMemory)
           ->Allocate(AllocSize, (MemRegion**)&TheMemory);
 #else
-  IdentifierBucket* Identifier = (IdentifierBucket*)malloc(AllocSize);
+  IdentifierTokenInfo* Identifier = (IdentifierTokenInfo*)malloc(AllocSize);
 #endif
-  Identifier->TokInfo.NameLen = Length;
-  Identifier->TokInfo.Macro = 0;
-  Identifier->TokInfo.TokenID = tok::identifier;
-  Identifier->TokInfo.IsExtension = false;
-  Identifier->TokInfo.FETokenInfo = 0;
+  Identifier->NameLen = Length;
+  Identifier->Macro = 0;
+  Identifier->TokenID = tok::identifier;
+  Identifier->PPKeywordID = tok::pp_not_keyword;
+  Identifier->IsExtension = false;
+  Identifier->FETokenInfo = 0;
+
+  // If this is a keyword or directive name, say so.  Keywords that are
+  // disabled in this language, or are extensions when extensions are
+  // disabled, stay identifiers.
+  if (const KeywordInfo* KW = LookupKeyword(NameStart, Length, FullHash)) {
+    Identifier->PPKeywordID = KW->PPKeywordID;
+    unsigned Flags = (KW->Flags >> KeywordLangShift) & LangMask;
+    if (KW->TokenID != tok::identifier && Flags + NoExtensions < 2) {
+      Identifier->TokenID = KW->TokenID;
+      Identifier->IsExtension = Flags == 1;
+    }
+  }
 
   // Copy the string information.
   char* StrBuffer = (char*)(Identifier + 1);
   memcpy(StrBuffer, NameStart, Length);
   StrBuffer[Length] = 0;  // Null terminate string.
 
-  // Link it into the hash table.
-  Identifier->Next = IdentHead;
-  TableArray[Hash] = Identifier;
-  return Identifier->TokInfo;
+  // Put it in the empty slot the probe ended on.  Keep the load factor under
+  // 3/4, past that linear probe sequences get long quickly.
+  Table[Idx].FullHash = FullHash;
+  Table[Idx].Info = Identifier;
+  if (++NumIdentifiers * 4 > TableSize * 3)
+    Grow();
+  return *Identifier;
 }
 
 IdentifierTokenInfo& IdentifierTable::get(const std::string& Name) {
@@ -200,38 +372,49 @@ IdentifierTokenInfo& IdentifierTable::get(const std::string& Name) {
 /// PrintStats - Print statistics about how well the identifier table is doing
 /// at hashing identifiers.
 void IdentifierTable::PrintStats() const {
-  unsigned NumIdentifiers = 0;
-  unsigned NumEmptyBuckets = 0;
-  unsigned MaxBucketLength = 0;
   unsigned AverageIdentifierSize = 0;
   unsigned MaxIdentifierLength = 0;
 
-  IdentifierBucket** TableArray = (IdentifierBucket**)TheTable;
-  for (unsigned i = 0, e = HASH_TABLE_SIZE; i != e; ++i) {
-    unsigned NumIdentifiersInBucket = 0;
-    for (IdentifierBucket* Id = TableArray[i]; Id; Id = Id->Next) {
-      AverageIdentifierSize += Id->TokInfo.getNameLength();
-      if (MaxIdentifierLength < Id->TokInfo.getNameLength())
-        MaxIdentifierLength = Id->TokInfo.getNameLength();
-      ++NumIdentifiersInBucket;
-    }
-    if (NumIdentifiersInBucket > MaxBucketLength)
-      MaxBucketLength = NumIdentifiersInBucket;
-    if (NumIdentifiersInBucket == 0)
-      ++NumEmptyBuckets;
-
-    NumIdentifiers += NumIdentifiersInBucket;
+  // ProbeHistogram[i] - The number of identifiers found by a probe of length
+  // i+1, i.e. that many slots from their home slot.  The last entry counts all
+  // longer probes.
+  enum { NumHistogramBuckets = 9 };
+  unsigned ProbeHistogram[NumHistogramBuckets] = {};
+  unsigned TotalProbeLength = 0;
+  unsigned MaxProbeLength = 0;
+
+  IdentifierSlot* Table = (IdentifierSlot*)TheTable;
+  unsigned Mask = TableSize - 1;
+  for (unsigned i = 0, e = TableSize; i != e; ++i) {
+    IdentifierTokenInfo* Id = Table[i].Info;
+    if (Id == 0)
+      continue;
+    AverageIdentifierSize += Id->getNameLength();
+    if (MaxIdentifierLength < Id->getNameLength())
+      MaxIdentifierLength = Id->getNameLength();
+
+    unsigned ProbeLength = ((i - Table[i].FullHash) & Mask) + 1;
+    TotalProbeLength += ProbeLength;
+    if (MaxProbeLength < ProbeLength)
+      MaxProbeLength = ProbeLength;
+    if (ProbeLength > NumHistogramBuckets)
+      ProbeLength = NumHistogramBuckets;
+    ++ProbeHistogram[ProbeLength - 1];
   }
 
   std::cerr << "\n*** Identifier Table Stats:\n";
   std::cerr << "# Identifiers:   " << NumIdentifiers << "\n";
-  std::cerr << "# Empty Buckets: " << NumEmptyBuckets << "\n";
-  std::cerr << "Max identifiers in one bucket: " << MaxBucketLength << "\n";
-  std::cerr << "Hash density (#identifiers per bucket): "
-            << NumIdentifiers / (double)HASH_TABLE_SIZE << "\n";
-  std::cerr << "Nonempty hash density (average chain length): "
-            << NumIdentifiers / (double)(HASH_TABLE_SIZE - NumEmptyBuckets)
-            << "\n";
+  std::cerr << "# Slots:         " << TableSize << " (grown " << NumGrows
+            << " times)\n";
+  std::cerr << "Load factor: " << NumIdentifiers / (double)TableSize << "\n";
+  std::cerr << "Ave probe length: "
+            << TotalProbeLength / (double)NumIdentifiers << "\n";
+  std::cerr << "Max probe length: " << MaxProbeLength << "\n";
+  std::cerr << "Probe length histogram:\n";
+  for (unsigned i = 0; i != NumHistogramBuckets; ++i) {
+    std::cerr << "  " << (i + 1) << (i + 1 == NumHistogramBuckets ? "+" : "")
+              << ": " << ProbeHistogram[i] << "\n";
+  }
   std::cerr << "Ave identifier length: "
             << (AverageIdentifierSize / (double)NumIdentifiers) << "\n";
   std::cerr << "Max identifier length: " << MaxIdentifierLength << "\n";
@@ -1,26 +1,28 @@
 #include "tinyclang/Lexer/Lexer.h"
 
 #include <cctype>
+#include <cstdint>
 #include <iostream>
 
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 #include "tinyclang/Diagnostic/Diagnostic.h"
 #include "tinyclang/Lexer/Preprocessor.h"
-#include "tinyclang/Source/SourceLocation.h"
+#include "tinyclang/Source/SourceManager.h"
 
 namespace tinyclang {
 
-static void InitCharacterInfo();
-
 Lexer::Lexer(const llvm::MemoryBuffer* File, unsigned fileid, Preprocessor& pp)
     : BufferPtr(File->getBufferStart()),
       BufferStart(BufferPtr),
       BufferEnd(File->getBufferEnd()),
       InputFile(File),
       CurFileID(fileid),
+      FileLoc(pp.getSourceManager().getLocForStartOfFile(fileid)),
       PP(pp),
       Features(PP.getLangOptions()) {
-  InitCharacterInfo();
-
   assert(BufferEnd[0] == 0 &&
          "We assume that the input buffer has a null character at the end"
          " to simplify lexing!");
@@ -39,23 +41,17 @@ Lexer::Lexer(const llvm::MemoryBuffer* File, unsigned fileid, Preprocessor& pp)
 // LexerToken implementation.
 //===----------------------------------------------------------------------===//
 
-/// getSourceLocation - Return a source location identifier for the specified
-/// offset in the current file.
-SourceLocation LexerToken::getSourceLocation() const {
-  if (TheLexer)
-    return TheLexer->getSourceLocation(Start);
-  return SourceLocation();
-}
-
 /// dump - Print the token to stderr, used for debugging.
 ///
-void LexerToken::dump(const LangOptions& Features, bool DumpFlags) const {
+void LexerToken::dump(const SourceManager& SourceMgr,
+                      const LangOptions& Features, bool DumpFlags) const {
   std::cerr << tinyclang::tok::getTokenName(Kind).str() << " '";
 
+  const char* TokStart = SourceMgr.getCharacterData(Loc);
   if (needsCleaning())
-    std::cerr << Lexer::getSpelling(*this, Features);
+    std::cerr << Lexer::getSpelling(*this, SourceMgr, Features);
   else
-    std::cerr << std::string(getStart(), getEnd());
+    std::cerr << std::string(TokStart, Length);
   std::cerr << "'";
 
   if (DumpFlags) {
@@ -65,7 +61,7 @@ void LexerToken::dump(const LangOptions& Features, bool DumpFlags) const {
     if (hasLeadingSpace())
       std::cerr << " [LeadingSpace]";
     if (needsCleaning())
-      std::cerr << " [Spelling='" << std::string(getStart(), getEnd()) << "']";
+      std::cerr << " [Spelling='" << std::string(TokStart, Length) << "']";
   }
 }
 
@@ -73,40 +69,55 @@ void LexerToken::dump(const LangOptions& Features, bool DumpFlags) const {
 // Character information.
 //===----------------------------------------------------------------------===//
 
-static unsigned char CharInfo[256];
-
 enum {
   CHAR_HORZ_WS = 0x01,  // ' ', '\t', '\f', '\v'.  Note, no '\0'
   CHAR_VERT_WS = 0x02,  // '\r', '\n'
   CHAR_LETTER = 0x04,   // a-z,A-Z
   CHAR_NUMBER = 0x08,   // 0-9
   CHAR_UNDER = 0x10,    // _
-  CHAR_PERIOD = 0x20    // .
+  CHAR_PERIOD = 0x20,   // .
+  CHAR_SLOW = 0x40,     // '?', '\\': may start a trigraph or escaped newline.
+
+  CHAR_ID_HEAD = CHAR_LETTER | CHAR_UNDER,
+  CHAR_ID_BODY = CHAR_ID_HEAD | CHAR_NUMBER,
+  CHAR_NUMBER_BODY = CHAR_ID_BODY | CHAR_PERIOD,
+  CHAR_WS = CHAR_HORZ_WS | CHAR_VERT_WS
 };
 
-static void InitCharacterInfo() {
-  static bool isInited = false;
-  if (isInited)
-    return;
-  isInited = true;
-
-  // Intiialize the CharInfo table.
-  // TODO: statically initialize this.
-  CharInfo[(int)' '] = CharInfo[(int)'\t'] = CharInfo[(int)'\f'] =
-      CharInfo[(int)'\v'] = CHAR_HORZ_WS;
-  CharInfo[(int)'\n'] = CharInfo[(int)'\r'] = CHAR_VERT_WS;
-
-  CharInfo[(int)'_'] = CHAR_UNDER;
-  for (unsigned i = 'a'; i <= 'z'; ++i)
-    CharInfo[i] = CharInfo[i + 'A' - 'a'] = CHAR_LETTER;
-  for (unsigned i = '0'; i <= '9'; ++i)
-    CharInfo[i] = CHAR_NUMBER;
+/// CharInfoTable - The classification of every character, built at compile
+/// time so that it costs nothing at startup.
+struct CharInfoTable {
+  unsigned char Info[256] = {};
+
+  constexpr CharInfoTable() {
+    Info[(int)' '] = Info[(int)'\t'] = Info[(int)'\f'] = Info[(int)'\v'] =
+        CHAR_HORZ_WS;
+    Info[(int)'\n'] = Info[(int)'\r'] = CHAR_VERT_WS;
+
+    Info[(int)'_'] = CHAR_UNDER;
+    Info[(int)'.'] = CHAR_PERIOD;
+    Info[(int)'?'] = Info[(int)'\\'] = CHAR_SLOW;
+    for (unsigned i = 'a'; i <= 'z'; ++i)
+      Info[i] = Info[i + 'A' - 'a'] = CHAR_LETTER;
+    for (unsigned i = '0'; i <= '9'; ++i)
+      Info[i] = CHAR_NUMBER;
+  }
+
+  constexpr unsigned char operator[](unsigned char C) const { return Info[C]; }
+};
+
+static constexpr CharInfoTable CharInfo;
+
+/// isIdentifierHead - Return true if this is the first character of an
+/// identifier, which is [a-zA-Z_].
+static inline bool isIdentifierHead(unsigned char c) {
+  return CharInfo[c] & CHAR_ID_HEAD;
 }
 
 /// isIdentifierBody - Return true if this is the body character of an
 /// identifier, which is [a-zA-Z0-9_].
 static inline bool isIdentifierBody(unsigned char c) {
-  return CharInfo[c] & (CHAR_LETTER | CHAR_NUMBER | CHAR_UNDER);
+  return CharInfo[c] & CHAR_ID_BODY;
 }
 
 /// isHorizontalWhitespace - Return true if this character is horizontal
@@ -119,13 +130,95 @@ static inline bool isHorizontalWhitespace(unsigned char c) {
 /// whitespace: ' ', '\t', '\f', '\v', '\n', '\r'.  Note that this returns false
 /// for '\0'.
 static inline bool isWhitespace(unsigned char c) {
-  return CharInfo[c] & (CHAR_HORZ_WS | CHAR_VERT_WS);
+  return CharInfo[c] & CHAR_WS;
 }
 
 /// isNumberBody - Return true if this is the body character of an
 /// preprocessing number, which is [a-zA-Z0-9_.].
 static inline bool isNumberBody(unsigned char c) {
-  return CharInfo[c] & (CHAR_LETTER | CHAR_NUMBER | CHAR_UNDER | CHAR_PERIOD);
+  return CharInfo[c] & CHAR_NUMBER_BODY;
+}
+
+/// isSlowChar - Return true if this character may start a trigraph, an
+/// escaped newline or a UCN, which need getCharAndSizeSlow: '?' and '\\'.
+static inline bool isSlowChar(unsigned char c) {
+  return CharInfo[c] & CHAR_SLOW;
+}
+
+//===----------------------------------------------------------------------===//
+// Vectorized character searches.
+//===----------------------------------------------------------------------===//
+
+// These look at a block of bytes at a time: 32 with AVX2, 16 with SSE2, which
+// every x86-64 CPU has.  The choice is made at compile time, since these are
+// inlined into the lexer's inner loops.  The loads are aligned, and an aligned
+// block never straddles a page, so reading the bytes before the start pointer
+// or past the NUL at the end of the buffer is safe; they are ignored.
+
+#if defined(__AVX2__)
+enum { CharBlockSize = 32 };
+
+/// MatchMask - Return a mask with bit i set if Block[i] is one of Chars.
+template <char... Chars>
+static inline uint32_t MatchMask(const char* Block) {
+  __m256i Bytes = _mm256_load_si256((const __m256i*)Block);
+  __m256i Hits = _mm256_setzero_si256();
+  ((Hits = _mm256_or_si256(Hits,
+                           _mm256_cmpeq_epi8(Bytes, _mm256_set1_epi8(Chars)))),
+   ...);
+  return (uint32_t)_mm256_movemask_epi8(Hits);
+}
+#elif defined(__SSE2__)
+enum { CharBlockSize = 16 };
+
+template <char... Chars>
+static inline uint32_t MatchMask(const char* Block) {
+  __m128i Bytes = _mm_load_si128((const __m128i*)Block);
+  __m128i Hits = _mm_setzero_si128();
+  ((Hits = _mm_or_si128(Hits, _mm_cmpeq_epi8(Bytes, _mm_set1_epi8(Chars)))),
+   ...);
+  return (uint32_t)_mm_movemask_epi8(Hits);
+}
+#endif
+
+/// FindFirst - Return a pointer to the first character at or after Ptr that is
+/// one of Chars, or with Negate, that isn't.  Either way the NUL at the end of
+/// the buffer must stop the search.
+template <bool Negate, char... Chars>
+static inline const char* FindFirst(const char* Ptr) {
+#if defined(__AVX2__) || defined(__SSE2__)
+  const uint32_t AllBytes = (uint32_t)((1ULL << CharBlockSize) - 1);
+  const char* Block =
+      (const char*)((uintptr_t)Ptr & ~(uintptr_t)(CharBlockSize - 1));
+  uint32_t Mask = MatchMask<Chars...>(Block);
+  if (Negate)
+    Mask ^= AllBytes;
+  Mask &= AllBytes << (Ptr - Block);
+  while (Mask == 0) {
+    Block += CharBlockSize;
+    Mask = MatchMask<Chars...>(Block);
+    if (Negate)
+      Mask ^= AllBytes;
+  }
+  return Block + __builtin_ctz(Mask);
+#else
+  while (((*Ptr != Chars) && ...) != Negate)
+    ++Ptr;
+  return Ptr;
+#endif
+}
+
+/// FindFirstOf - Return a pointer to the first character at or after Ptr that
+/// is one of Chars, which must include the NUL.
+template <char... Chars>
+static inline const char* FindFirstOf(const char* Ptr) {
+  return FindFirst<false, Chars...>(Ptr);
+}
+
+/// SkipHorizontalWhitespace - Return a pointer to the first character at or
+/// after Ptr that isn't horizontal whitespace.
+static inline const char* SkipHorizontalWhitespace(const char* Ptr) {
+  return FindFirst<true, ' ', '\t', '\f', '\v'>(Ptr);
 }
 
 //===----------------------------------------------------------------------===//
@@ -138,7 +231,7 @@ SourceLocation Lexer::getSourceLocation(const char* Loc) const {
   assert(Loc >= InputFile->getBufferStart() &&
          Loc <= InputFile->getBufferEnd() &&
          "Location out of range for this buffer!");
-  return SourceLocation(CurFileID, Loc - InputFile->getBufferStart());
+  return FileLoc.getLocWithOffset(Loc - InputFile->getBufferStart());
 }
 
 /// Diag - Forwarding function for diagnostics.  This translate a source
@@ -359,18 +452,24 @@ static inline char getCharAndSizeNoWarn(const char* Ptr, unsigned& Size,
 /// wants to get the true, uncanonicalized, spelling of things like digraphs
 /// UCNs, etc.
 std::string Lexer::getSpelling(const LexerToken& Tok,
+                               const SourceManager& SourceMgr,
                                const LangOptions& Features) {
-  assert(Tok.getStart() <= Tok.getEnd() && "Token character range is bogus!");
+  return getSpelling(Tok, SourceMgr.getCharacterData(Tok.getSourceLocation()),
+                     Features);
+}
 
+std::string Lexer::getSpelling(const LexerToken& Tok, const char* TokStart,
+                               const LangOptions& Features) {
   // If this token contains nothing interesting, return it directly.
   if (!Tok.needsCleaning())
-    return std::string(Tok.getStart(), Tok.getEnd());
+    return std::string(TokStart, Tok.getLength());
 
   // Otherwise, hard case, relex the characters into the string.
   std::string Result;
   Result.reserve(Tok.getLength());
 
-  for (const char *Ptr = Tok.getStart(), *End = Tok.getEnd(); Ptr != End;) {
+  for (const char *Ptr = TokStart, *End = TokStart + Tok.getLength();
+       Ptr != End;) {
     unsigned CharSize;
     Result.push_back(getCharAndSizeNoWarn(Ptr, CharSize, Features));
     Ptr += CharSize;
@@ -383,23 +482,26 @@ std::string Lexer::getSpelling(const LexerToken& Tok,
 /// getSpelling - This method is used to get the spelling of a token into a
 /// preallocated buffer, instead of as an std::string.  The caller is required
 /// to allocate enough space for the token, which is guaranteed to be at most
-/// Tok.End-Tok.Start bytes long.  The actual length of the token is returned.
+/// Tok.getLength() bytes long.  The actual length of the token is returned.
 unsigned Lexer::getSpelling(const LexerToken& Tok, char* Buffer,
+                            const SourceManager& SourceMgr,
                             const LangOptions& Features) {
-  assert(Tok.getStart() <= Tok.getEnd() && "Token character range is bogus!");
+  return getSpelling(Tok, SourceMgr.getCharacterData(Tok.getSourceLocation()),
+                     Buffer, Features);
+}
 
+unsigned Lexer::getSpelling(const LexerToken& Tok, const char* TokStart,
+                            char* Buffer, const LangOptions& Features) {
   // If this token contains nothing interesting, return it directly.
   if (!Tok.needsCleaning()) {
     unsigned Size = Tok.getLength();
-    memcpy(Buffer, Tok.getStart(), Size);
+    memcpy(Buffer, TokStart, Size);
     return Size;
   }
-  // Otherwise, hard case, relex the characters into the string.
-  std::string Result;
-  Result.reserve(Tok.getLength());
-
+  // Otherwise, hard case, relex the characters into the buffer.
   char* OutBuf = Buffer;
-  for (const char *Ptr = Tok.getStart(), *End = Tok.getEnd(); Ptr != End;) {
+  for (const char *Ptr = TokStart, *End = TokStart + Tok.getLength();
+       Ptr != End;) {
     unsigned CharSize;
     *OutBuf++ = getCharAndSizeNoWarn(Ptr, CharSize, Features);
     Ptr += CharSize;
@@ -415,10 +517,16 @@ unsigned Lexer::getSpelling(const LexerToken& Tok, char* Buffer,
 //===----------------------------------------------------------------------===//
 
 void Lexer::LexIdentifier(LexerToken& Result, const char* CurPtr) {
-  // Match [_A-Za-z0-9]*, we have already matched [_A-Za-z$]
+  // Match [_A-Za-z0-9]*, we have already matched [_A-Za-z$].  Hash the
+  // identifier as we go, so that looking it up doesn't need another pass over
+  // its characters.  Both paths hash the characters as they are consumed, after
+  // trigraphs and escaped newlines are folded, so this is the hash of the
+  // spelling.
   unsigned Size;
+  unsigned Hash = IdentifierTable::HashChar(0, CurPtr[-1]);
   unsigned char C = *CurPtr++;
   while (isIdentifierBody(C)) {
+    Hash = IdentifierTable::HashChar(Hash, C);
     C = *CurPtr++;
   }
   --CurPtr;  // Back up over the skipped character.
@@ -426,17 +534,18 @@ void Lexer::LexIdentifier(LexerToken& Result, const char* CurPtr) {
   // Fast path, no $,\,? in identifier found.  '\' might be an escaped newline
   // or UCN, and ? might be a trigraph for '\', an escaped newline or UCN.
   // FIXME: universal chars.
-  if (C != '\\' && C != '?' && (C != '$' || !Features.DollarIdents)) {
+  if (!isSlowChar(C) && (C != '$' || !Features.DollarIdents)) {
   FinishIdentifier:
-    Result.SetEnd(BufferPtr = CurPtr);
+    FormTokenWithChars(Result, CurPtr);
     Result.SetKind(tok::identifier);
+    MIOpt.ReadToken();
 
     // Look up this token, see if it is a macro, or if it is a language keyword.
     const char *SpelledTokStart, *SpelledTokEnd;
     if (!Result.needsCleaning()) {
       // No cleaning needed, just use the characters from the lexed buffer.
-      SpelledTokStart = Result.getStart();
-      SpelledTokEnd = Result.getEnd();
+      SpelledTokStart = getBufferLocation(Result.getSourceLocation());
+      SpelledTokEnd = CurPtr;
     } else {
       // Cleaning needed, alloca a buffer, clean into it, then use the buffer.
       char* TmpBuf = (char*)alloca(Result.getLength());
@@ -445,8 +554,12 @@ void Lexer::LexIdentifier(LexerToken& Result, const char* CurPtr) {
       SpelledTokEnd = TmpBuf + Size;
     }
 
+    Hash = IdentifierTable::HashFinish(Hash);
+    assert(Hash ==
+               IdentifierTable::HashString(SpelledTokStart, SpelledTokEnd) &&
+           "Identifier hashed incorrectly while lexing!");
     Result.SetIdentifierInfo(
-        PP.getIdentifierInfo(SpelledTokStart, SpelledTokEnd));
+        PP.getIdentifierInfo(SpelledTokStart, SpelledTokEnd, Hash));
     return PP.HandleIdentifier(Result);
   }
 
@@ -461,6 +574,7 @@ void Lexer::LexIdentifier(LexerToken& Result, const char* CurPtr) {
 
       // Otherwise, emit a diagnostic and continue.
       Diag(CurPtr, diag::ext_dollar_in_identifier);
+      Hash = IdentifierTable::HashChar(Hash, C);
       CurPtr = ConsumeChar(CurPtr, Size, Result);
       C = getCharAndSize(CurPtr, Size);
       continue;
@@ -470,10 +584,12 @@ void Lexer::LexIdentifier(LexerToken& Result, const char* CurPtr) {
     }
 
     // Otherwise, this character is good, consume it.
+    Hash = IdentifierTable::HashChar(Hash, C);
     CurPtr = ConsumeChar(CurPtr, Size, Result);
 
     C = getCharAndSize(CurPtr, Size);
     while (isIdentifierBody(C)) {  // FIXME: universal chars.
+      Hash = IdentifierTable::HashChar(Hash, C);
       CurPtr = ConsumeChar(CurPtr, Size, Result);
       C = getCharAndSize(CurPtr, Size);
     }
@@ -484,9 +600,13 @@ void Lexer::LexIdentifier(LexerToken& Result, const char* CurPtr) {
 /// constant. From[-1] is the first character lexed.  Return the end of the
 /// constant.
 void Lexer::LexNumericConstant(LexerToken& Result, const char* CurPtr) {
+  // Skip the plain characters quickly, then use getCharAndSize for the rest.
+  char PrevCh = CurPtr[-1];
+  while (isNumberBody(*CurPtr))
+    PrevCh = *CurPtr++;
+
   unsigned Size;
   char C = getCharAndSize(CurPtr, Size);
-  char PrevCh = 0;
   while (isNumberBody(C)) {  // FIXME: universal chars?
     CurPtr = ConsumeChar(CurPtr, Size, Result);
     PrevCh = C;
@@ -505,7 +625,8 @@ void Lexer::LexNumericConstant(LexerToken& Result, const char* CurPtr) {
   Result.SetKind(tok::numeric_constant);
 
   // Update the end of token position as well as the BufferPtr instance var.
-  Result.SetEnd(BufferPtr = CurPtr);
+  FormTokenWithChars(Result, CurPtr);
+  MIOpt.ReadToken();
 }
 
 /// LexStringLiteral - Lex the remainder of a string literal, after having lexed
@@ -521,7 +642,7 @@ void Lexer::LexStringLiteral(LexerToken& Result, const char* CurPtr) {
       C = getAndAdvanceChar(CurPtr, Result);
     } else if (C == '\n' || C == '\r' ||               // Newline.
                (C == 0 && CurPtr - 1 == BufferEnd)) {  // End of file.
-      Diag(Result.getStart(), diag::err_unterminated_string);
+      PP.Diag(Result, diag::err_unterminated_string);
       BufferPtr = CurPtr - 1;
       return LexTokenInternal(Result);
     } else if (C == 0) {
@@ -536,7 +657,8 @@ void Lexer::LexStringLiteral(LexerToken& Result, const char* CurPtr) {
   Result.SetKind(tok::string_literal);
 
   // Update the end of token position as well as the BufferPtr instance var.
-  Result.SetEnd(BufferPtr = CurPtr);
+  FormTokenWithChars(Result, CurPtr);
+  MIOpt.ReadToken();
 }
 
 /// LexAngledStringLiteral - Lex the remainder of an angled string literal,
@@ -552,7 +674,7 @@ void Lexer::LexAngledStringLiteral(LexerToken& Result, const char* CurPtr) {
       C = getAndAdvanceChar(CurPtr, Result);
     } else if (C == '\n' || C == '\r' ||               // Newline.
                (C == 0 && CurPtr - 1 == BufferEnd)) {  // End of file.
-      Diag(Result.getStart(), diag::err_unterminated_string);
+      PP.Diag(Result, diag::err_unterminated_string);
       BufferPtr = CurPtr - 1;
       return LexTokenInternal(Result);
     } else if (C == 0) {
@@ -567,7 +689,8 @@ void Lexer::LexAngledStringLiteral(LexerToken& Result, const char* CurPtr) {
   Result.SetKind(tok::angle_string_literal);
 
   // Update the end of token position as well as the BufferPtr instance var.
-  Result.SetEnd(BufferPtr = CurPtr);
+  FormTokenWithChars(Result, CurPtr);
+  MIOpt.ReadToken();
 }
 
 /// LexCharConstant - Lex the remainder of a character constant, after having
@@ -579,7 +702,7 @@ void Lexer::LexCharConstant(LexerToken& Result, const char* CurPtr) {
   // Handle the common case of 'x' and '\y' efficiently.
   char C = getAndAdvanceChar(CurPtr, Result);
   if (C == '\'') {
-    Diag(Result.getStart(), diag::err_empty_character);
+    PP.Diag(Result, diag::err_empty_character);
     BufferPtr = CurPtr;
     return LexTokenInternal(Result);
   } else if (C == '\\') {
@@ -599,7 +722,7 @@ void Lexer::LexCharConstant(LexerToken& Result, const char* CurPtr) {
         C = getAndAdvanceChar(CurPtr, Result);
       } else if (C == '\n' || C == '\r' ||               // Newline.
                  (C == 0 && CurPtr - 1 == BufferEnd)) {  // End of file.
-        Diag(Result.getStart(), diag::err_unterminated_char);
+        PP.Diag(Result, diag::err_unterminated_char);
         BufferPtr = CurPtr - 1;
         return LexTokenInternal(Result);
       } else if (C == 0) {
@@ -615,7 +738,8 @@ void Lexer::LexCharConstant(LexerToken& Result, const char* CurPtr) {
   Result.SetKind(tok::char_constant);
 
   // Update the end of token position as well as the BufferPtr instance var.
-  Result.SetEnd(BufferPtr = CurPtr);
+  FormTokenWithChars(Result, CurPtr);
+  MIOpt.ReadToken();
 }
 
 /// SkipWhitespace - Efficiently skip over a series of whitespace characters.
@@ -624,7 +748,12 @@ void Lexer::SkipWhitespace(LexerToken& Result, const char* CurPtr) {
   // Whitespace - Skip it, then return the token after the whitespace.
   unsigned char Char = *CurPtr;  // Skip consequtive spaces efficiently.
   while (1) {
-    // Skip horizontal whitespace very aggressively.
+    // Skip horizontal whitespace very aggressively.  A run of more than one
+    // character is usually indentation, find the end of it a block at a time.
+    if (isHorizontalWhitespace(Char) && isHorizontalWhitespace(CurPtr[1])) {
+      CurPtr = SkipHorizontalWhitespace(CurPtr + 2);
+      Char = *CurPtr;
+    }
     while (isHorizontalWhitespace(Char))
       Char = *++CurPtr;
 
@@ -654,11 +783,11 @@ void Lexer::SkipWhitespace(LexerToken& Result, const char* CurPtr) {
   // If the next token is obviously a // or /* */ comment, skip it efficiently
   // too (without going through the big switch stmt).
   if (Char == '/' && CurPtr[1] == '/') {
-    Result.SetStart(CurPtr);
+    Result.SetLocation(getSourceLocation(CurPtr));
     return SkipBCPLComment(Result, CurPtr + 1);
   }
   if (Char == '/' && CurPtr[1] == '*') {
-    Result.SetStart(CurPtr);
+    Result.SetLocation(getSourceLocation(CurPtr));
     return SkipBlockComment(Result, CurPtr + 2);
   }
   BufferPtr = CurPtr;
@@ -671,7 +800,7 @@ void Lexer::SkipBCPLComment(LexerToken& Result, const char* CurPtr) {
   // If BCPL comments aren't explicitly enabled for this language, emit an
   // extension warning.
   if (!Features.BCPLComment) {
-    Diag(Result.getStart(), diag::ext_bcpl_comment);
+    PP.Diag(Result, diag::ext_bcpl_comment);
 
     // Mark them enabled so we only emit one warning for this translation
     // unit.
@@ -683,17 +812,14 @@ void Lexer::SkipBCPLComment(LexerToken& Result, const char* CurPtr) {
   // them.  As such, optimize for this case with the inner loop.
   char C;
   do {
-    C = *CurPtr;
     // FIXME: just scan for a \n or \r character.  If we find a \n character,
     // scan backwards, checking to see if it's an escaped newline, like we do
     // for block comments.
 
-    // Skip over characters in the fast loop.
-    while (C != 0 &&                // Potentially EOF.
-           C != '\\' &&             // Potentially escaped newline.
-           C != '?' &&              // Potentially trigraph.
-           C != '\n' && C != '\r')  // Newline or DOS-style newline.
-      C = *++CurPtr;
+    // Skip over characters in the fast loop: stop at a potential EOF, escaped
+    // newline or trigraph, or at a newline.
+    CurPtr = FindFirstOf<'\0', '\\', '?', '\n', '\r'>(CurPtr);
+    C = *CurPtr;
 
     // If this is a newline, we're done.
     if (C == '\n' || C == '\r')
@@ -824,16 +950,17 @@ void Lexer::SkipBlockComment(LexerToken& Result, const char* CurPtr) {
   // comments.
   unsigned char C = *CurPtr++;
   if (C == 0 && CurPtr == BufferEnd + 1) {
-    Diag(Result.getStart(), diag::err_unterminated_block_comment);
+    PP.Diag(Result, diag::err_unterminated_block_comment);
     BufferPtr = CurPtr - 1;
     return;
   }
 
   while (1) {
     // Skip over all non-interesting characters.
-    // TODO: Vectorize this.  Note: memchr on Darwin is slower than this loop.
-    while (C != '/' && C != '\0')
+    if (C != '/' && C != '\0') {
+      CurPtr = FindFirstOf<'/', '\0'>(CurPtr);
       C = *CurPtr++;
+    }
 
     if (C == '/') {
       char T;
@@ -854,7 +981,7 @@ void Lexer::SkipBlockComment(LexerToken& Result, const char* CurPtr) {
         Diag(CurPtr - 1, diag::nested_block_comment);
       }
     } else if (C == 0 && CurPtr == BufferEnd + 1) {
-      Diag(Result.getStart(), diag::err_unterminated_block_comment);
+      PP.Diag(Result, diag::err_unterminated_block_comment);
       // Note: the user probably forgot a */.  We could continue immediately
       // after the /*, but this would involve lexing a lot of what really is the
       // comment, which surely would confuse the parser.
@@ -877,6 +1004,335 @@ void Lexer::SkipBlockComment(LexerToken& Result, const char* CurPtr) {
   Result.SetFlag(LexerToken::LeadingSpace);
 }
 
+//===----------------------------------------------------------------------===//
+// Excluded Conditional Block Skipping
+//===----------------------------------------------------------------------===//
+
+/// SkipSimpleLiteral - Ptr points to the ' or " starting a character constant
+/// or string literal.  If the literal ends on this line without any escaped
+/// newlines, trigraphs or embedded NULs, and isn't an empty character
+/// constant, return a pointer past its closing quote.  Otherwise return null:
+/// the lexer has to look at it.
+static const char* SkipSimpleLiteral(const char* Ptr) {
+  char Quote = *Ptr++;
+  if (Quote == '\'' && *Ptr == '\'')
+    return 0;
+
+  while (1) {
+    Ptr = Quote == '"'
+              ? FindFirstOf<'"', '\\', '?', '\n', '\r', '\0'>(Ptr)
+              : FindFirstOf<'\'', '\\', '?', '\n', '\r', '\0'>(Ptr);
+    char C = *Ptr;
+    if (C == Quote)
+      return Ptr + 1;
+    if (C == '?' && Ptr[1] != '?') {
+      ++Ptr;
+    } else if (C == '\\' && Ptr[1] != '\\' && Ptr[1] != '?' &&
+               !isWhitespace(Ptr[1]) && Ptr[1] != 0) {
+      // A simple escape.  Anything else after the \ might be an escaped
+      // newline.
+      Ptr += 2;
+    } else {
+      return 0;
+    }
+  }
+}
+
+/// SkipToPossibleDirective - The preprocessor is skipping an excluded
+/// conditional block, where the only tokens that matter are '#'s at the start
+/// of a line.  Instead of lexing every token, scan a line at a time for one
+/// that starts with something that may be a '#', stepping over comments and
+/// literals so that a '#' or newline inside one isn't misread.  Anything the
+/// scanner doesn't handle (escaped newlines, trigraphs, unterminated literals
+/// and comments, NULs, the end of the buffer) is left to the lexer: BufferPtr
+/// is left at the last point known to be between tokens before it.  Lexing on
+/// from there gives the same tokens at the starts of lines, and the same
+/// errors, as lexing everything would have.  Warnings are off while skipping.
+void Lexer::SkipToPossibleDirective() {
+  assert(PP.isSkipping() && !ParsingPreprocessorDirective &&
+         "Only directive names are looked at while skipping!");
+
+  const char* CurPtr = BufferPtr;
+  bool AtStartOfLine = IsAtStartOfLine;
+  while (1) {
+    // Everything before CurPtr has been skipped, and CurPtr is between tokens.
+    BufferPtr = CurPtr;
+    IsAtStartOfLine = AtStartOfLine;
+
+    if (AtStartOfLine) {
+      while (isHorizontalWhitespace(*CurPtr))
+        ++CurPtr;
+
+      char C = *CurPtr;
+      if (C == '\n' || C == '\r') {
+        ++CurPtr;
+        continue;
+      }
+
+      // This may be a directive, spelled with a #, %: or ??=.
+      if (C == '#' || C == '%' || C == '?')
+        return;
+
+      // Unless this is a comment, this line doesn't start with a directive.
+      // Literals and things for the lexer are dealt with below.
+      if (C != '/' && C != '"' && C != '\'' && C != '\\' && C != 0)
+        AtStartOfLine = false;
+    }
+
+    CurPtr = FindFirstOf<'\n', '\r', '"', '\'', '/', '?', '\\', '\0'>(CurPtr);
+    switch (*CurPtr) {
+      case '\n':
+      case '\r':
+        ++CurPtr;
+        AtStartOfLine = true;
+        break;
+      case '"':
+      case '\'':
+        CurPtr = SkipSimpleLiteral(CurPtr);
+        if (CurPtr == 0)
+          return;
+        AtStartOfLine = false;
+        break;
+      case '/':
+        if (CurPtr[1] == '*') {
+          // A block comment is whitespace, so this doesn't change whether
+          // the next token is at the start of a line.  Like SkipBlockComment,
+          // this treats "/*/" as a whole comment.  An escaped newline before
+          // the final / needs the lexer.
+          const char* End = CurPtr + 2;
+          while (1) {
+            End = FindFirstOf<'/', '\0'>(End);
+            if (*End == 0 || End[-1] == '\n' || End[-1] == '\r')
+              return;
+            if (End[-1] == '*')
+              break;
+            ++End;
+          }
+          CurPtr = End + 1;
+        } else if (CurPtr[1] == '/') {
+          // The lexer warns about the first // comment if they aren't
+          // enabled, then enables them.
+          if (!Features.BCPLComment)
+            return;
+
+          // The comment runs to the end of the line, unless the newline is
+          // escaped with a \ or ??/, possibly followed by whitespace.
+          const char* End = FindFirstOf<'\n', '\r', '\0'>(CurPtr + 2);
+          const char* Last = End - 1;
+          while (isHorizontalWhitespace(*Last))
+            --Last;
+          if (*End == 0 || *Last == '\\' ||
+              (*Last == '/' && Last[-1] == '?' && Last[-2] == '?'))
+            return;
+          CurPtr = End;
+        } else if (CurPtr[1] == '\\' || CurPtr[1] == '?') {
+          // An escaped newline or trigraph could make this a comment.
+          return;
+        } else {
+          ++CurPtr;
+          AtStartOfLine = false;
+        }
+        break;
+      case '?':
+        if (CurPtr[1] == '?')
+          return;  // A trigraph, maybe ??/.
+        ++CurPtr;
+        AtStartOfLine = false;
+        break;
+      default:
+        // A \ or a NUL.
+        return;
+    }
+  }
+}
+
+/// SkipRawMacroBody - The preprocessor has just read the name of a #define.  If
+/// the rest of the line is an object-like macro body that lexes without any
+/// diagnostics, move BufferPtr to the end of the line (or to a // comment on
+/// it), so the next token is the eom, and return the end of the last token of
+/// the body.  The body is the old BufferPtr up to there, and a lexer starting
+/// at the old BufferPtr gets the same tokens from it later.  Anything else (a
+/// '(' or no whitespace after the name, trigraphs, escaped newlines followed
+/// by nothing or preceded by whitespace, unterminated literals and comments,
+/// nested comments, '$', stray characters, NULs, <? and >?) returns null and
+/// leaves BufferPtr alone.  So does a # or ## (or %: digraph), which #define
+/// has to check.
+const char* Lexer::SkipRawMacroBody() {
+  assert(ParsingPreprocessorDirective && "Not in a #define?");
+
+  const char* CurPtr = BufferPtr;
+  if (!isWhitespace(*CurPtr) && (*CurPtr != 0 || CurPtr != BufferEnd))
+    return 0;
+
+  // TokEnd - The end of the last character that is part of a token.
+  const char* TokEnd = CurPtr;
+  while (1) {
+    unsigned char C = *CurPtr;
+    if (isHorizontalWhitespace(C)) {
+      ++CurPtr;
+      continue;
+    }
+    if (isIdentifierBody(C)) {
+      TokEnd = ++CurPtr;
+      continue;
+    }
+
+    switch (C) {
+      case 0:
+        if (CurPtr != BufferEnd)
+          return 0;
+        // FALL THROUGH.
+      case '\n':
+      case '\r':
+        BufferPtr = CurPtr;
+        return TokEnd;
+      case '.': case '!': case '&': case '(': case ')': case '*': case '+':
+      case ',': case '-': case ':': case ';': case '<': case '=': case '>':
+      case '[': case ']': case '^': case '{': case '|': case '}': case '~':
+        TokEnd = ++CurPtr;
+        break;
+      case '%':
+        // A %: digraph is a #, maybe across an escaped newline.
+        if (CurPtr[1] == ':' || CurPtr[1] == '\\')
+          return 0;
+        TokEnd = ++CurPtr;
+        break;
+      case '?':
+        // A trigraph, or a C++ <? or >? operator, which is deprecated.  The <
+        // or > may be before an escaped newline.
+        if (CurPtr[1] == '?' || CurPtr[-1] == '<' || CurPtr[-1] == '>' ||
+            CurPtr[-1] == '\n' || CurPtr[-1] == '\r')
+          return 0;
+        TokEnd = ++CurPtr;
+        break;
+      case '\\':
+        // Only an escaped newline with nothing between the \ and newline.
+        if (CurPtr[1] == '\r' && CurPtr[2] == '\n')
+          CurPtr += 3;
+        else if (CurPtr[1] == '\n' || CurPtr[1] == '\r')
+          CurPtr += 2;
+        else
+          return 0;
+        if (*CurPtr == 0)
+          return 0;
+        break;
+      case '"':
+      case '\'':
+        CurPtr = SkipSimpleLiteral(CurPtr);
+        if (CurPtr == 0)
+          return 0;
+        TokEnd = CurPtr;
+        break;
+      case '/':
+        if (CurPtr[1] == '*') {
+          // As in SkipToPossibleDirective, but a nested /* is diagnosed.
+          const char* End = CurPtr + 2;
+          while (1) {
+            End = FindFirstOf<'/', '\0'>(End);
+            if (*End == 0 || End[-1] == '\n' || End[-1] == '\r')
+              return 0;
+            if (End[-1] == '*')
+              break;
+            if (End[1] == '*' && End[2] != '/')
+              return 0;
+            ++End;
+          }
+          CurPtr = End + 1;
+        } else if (CurPtr[1] == '/') {
+          // The comment is left to the lexer, which may warn about it.  Unless
+          // its newline is escaped, it is the end of the #define.
+          const char* End = FindFirstOf<'\n', '\r', '\0'>(CurPtr + 2);
+          const char* Last = End - 1;
+          while (isHorizontalWhitespace(*Last))
+            --Last;
+          if (*Last == '\\' ||
+              (*Last == '/' && Last[-1] == '?' && Last[-2] == '?'))
+            return 0;
+          BufferPtr = CurPtr;
+          return TokEnd;
+        } else if (CurPtr[1] == '\\' || CurPtr[1] == '?') {
+          return 0;
+        } else {
+          TokEnd = ++CurPtr;
+        }
+        break;
+      default:
+        // '$', '@', '`', control characters and anything not ASCII.
+        return 0;
+    }
+  }
+}
+
+/// isNextPPTokenLParen - Return 1 if the next token in the file is a '(', 0 if
+/// it is something else, or 2 if the file ends first.  This is how the
+/// preprocessor decides whether the name of a function-like macro is an
+/// invocation.  Whitespace, comments and escaped newlines are skipped like
+/// the lexer skips them; anything that would need a closer look, like a
+/// trigraph or a comment ending in an escaped newline, isn't a '('.
+unsigned Lexer::isNextPPTokenLParen() const {
+  const char* CurPtr = BufferPtr;
+  while (1) {
+    switch (*CurPtr) {
+      case '(':
+        return 1;
+      case ' ':
+      case '\t':
+      case '\f':
+      case '\v':
+        ++CurPtr;
+        break;
+      case '\n':
+      case '\r':
+        // The end of a directive is the end of the tokens it can see.
+        if (ParsingPreprocessorDirective)
+          return 0;
+        ++CurPtr;
+        break;
+      case '\\':
+        if (CurPtr[1] == '\r' && CurPtr[2] == '\n')
+          CurPtr += 3;
+        else if (CurPtr[1] == '\n' || CurPtr[1] == '\r')
+          CurPtr += 2;
+        else
+          return 0;
+        break;
+      case '/':
+        if (CurPtr[1] == '*') {
+          // As in SkipToPossibleDirective.
+          const char* End = CurPtr + 2;
+          while (1) {
+            End = FindFirstOf<'/', '\0'>(End);
+            if (*End == 0 || End[-1] == '\n' || End[-1] == '\r')
+              return 0;
+            if (End[-1] == '*')
+              break;
+            ++End;
+          }
+          CurPtr = End + 1;
+        } else if (CurPtr[1] == '/') {
+          const char* End = FindFirstOf<'\n', '\r', '\0'>(CurPtr + 2);
+          const char* Last = End - 1;
+          while (isHorizontalWhitespace(*Last))
+            --Last;
+          if (*Last == '\\' ||
+              (*Last == '/' && Last[-1] == '?' && Last[-2] == '?'))
+            return 0;
+          CurPtr = End;
+        } else {
+          return 0;
+        }
+        break;
+      case 0:
+        if (CurPtr != BufferEnd)
+          return 0;
+        // The eom comes before the end of the file.
+        return ParsingPreprocessorDirective ? 0 : 2;
+      default:
+        return 0;
+    }
+  }
+}
+
 //===----------------------------------------------------------------------===//
 // Primary Lexing Entry Points
 //===----------------------------------------------------------------------===//
@@ -899,7 +1355,7 @@ void Lexer::LexIncludeFilename(LexerToken& Result) {
 
   // No filename?
   if (Result.getKind() == tok::eom) {
-    Diag(Result.getStart(), diag::err_pp_expects_filename);
+    PP.Diag(Result, diag::err_pp_expects_filename);
     return;
   }
 
@@ -908,7 +1364,7 @@ void Lexer::LexIncludeFilename(LexerToken& Result) {
   Lex(EndTok);
 
   if (EndTok.getKind() != tok::eom) {
-    Diag(Result.getStart(), diag::err_pp_expects_filename);
+    PP.Diag(Result, diag::err_pp_expects_filename);
 
     // Lex until the end of the preprocessor directive line.
     while (EndTok.getKind() != tok::eom)
@@ -928,7 +1384,6 @@ std::string Lexer::ReadToEndOfLine() {
 
   // CurPtr - Cache BufferPtr in an automatic variable.
   const char* CurPtr = BufferPtr;
-  Tmp.SetStart(CurPtr);
 
   while (1) {
     char Char = getAndAdvanceChar(CurPtr, Tmp);
@@ -972,13 +1427,14 @@ void Lexer::LexEndOfFile(LexerToken& Result, const char* CurPtr) {
     ParsingPreprocessorDirective = false;
     Result.SetKind(tok::eom);
     // Update the end of token position as well as the BufferPtr instance var.
-    Result.SetEnd(BufferPtr = CurPtr);
+    FormTokenWithChars(Result, CurPtr);
     return;
   }
 
   // If we are in a #if directive, emit an error.
   while (!ConditionalStack.empty()) {
-    Diag(ConditionalStack.back().IfLoc, diag::err_pp_unterminated_conditional);
+    PP.Diag(ConditionalStack.back().IfLoc,
+            diag::err_pp_unterminated_conditional);
     ConditionalStack.pop_back();
   }
 
@@ -1004,12 +1460,24 @@ LexNextToken:
 
   // CurPtr - Cache BufferPtr in an automatic variable.
   const char* CurPtr = BufferPtr;
-  Result.SetStart(CurPtr);
+  Result.SetLocation(getSourceLocation(CurPtr));
 
   unsigned SizeTmp, SizeTmp2;  // Temporaries for use in cases below.
 
   // Read a character, advancing over it.
   char Char = getAndAdvanceChar(CurPtr, Result);
+
+  // C99 6.4.2: Identifiers.  C99 6.4.4.1/2: Integer and Floating Constants.
+  // Most tokens are one of these, so find them with the character table rather
+  // than the switch below.  L may start a wide literal, the switch handles it.
+  unsigned char Info = CharInfo[(unsigned char)Char];
+  if (Info & CHAR_ID_HEAD) {
+    if (Char != 'L')
+      return LexIdentifier(Result, CurPtr);
+  } else if (Info & CHAR_NUMBER) {
+    return LexNumericConstant(Result, CurPtr);
+  }
+
   switch (Char) {
     case 0:  // Null.
       // Found end of file?
@@ -1058,77 +1526,9 @@ LexNextToken:
       // Wide character constant.
       if (Char == '\'')
         return LexCharConstant(Result, ConsumeChar(CurPtr, SizeTmp, Result));
-      // FALL THROUGH, treating L like the start of an identifier.
-
-    // C99 6.4.2: Identifiers.
-    case 'A':
-    case 'B':
-    case 'C':
-    case 'D':
-    case 'E':
-    case 'F':
-    case 'G':
-    case 'H':
-    case 'I':
-    case 'J':
-    case 'K': /*'L'*/
-    case 'M':
-    case 'N':
-    case 'O':
-    case 'P':
-    case 'Q':
-    case 'R':
-    case 'S':
-    case 'T':
-    case 'U':
-    case 'V':
-    case 'W':
-    case 'X':
-    case 'Y':
-    case 'Z':
-    case 'a':
-    case 'b':
-    case 'c':
-    case 'd':
-    case 'e':
-    case 'f':
-    case 'g':
-    case 'h':
-    case 'i':
-    case 'j':
-    case 'k':
-    case 'l':
-    case 'm':
-    case 'n':
-    case 'o':
-    case 'p':
-    case 'q':
-    case 'r':
-    case 's':
-    case 't':
-    case 'u':
-    case 'v':
-    case 'w':
-    case 'x':
-    case 'y':
-    case 'z':
-    case '_':
+      // Otherwise, L is the start of an identifier.
       return LexIdentifier(Result, CurPtr);
 
-    // C99 6.4.4.1: Integer Constants.
-    // C99 6.4.4.2: Floating Constants.
-    case '0':
-    case '1':
-    case '2':
-    case '3':
-    case '4':
-    case '5':
-    case '6':
-    case '7':
-    case '8':
-    case '9':
-      return LexNumericConstant(Result, CurPtr);
-
     // C99 6.4.4: Character Constants.
     case '\'':
       return LexCharConstant(Result, CurPtr);
@@ -1325,7 +1725,7 @@ LexNextToken:
         CurPtr = ConsumeChar(CurPtr, SizeTmp, Result);
       } else if (Features.CPPMinMax && Char == '?') {  // <?
         CurPtr = ConsumeChar(CurPtr, SizeTmp, Result);
-        Diag(Result.getStart(), diag::min_max_deprecated);
+        PP.Diag(Result, diag::min_max_deprecated);
 
         if (getCharAndSize(CurPtr, SizeTmp) == '=') {  // <?=
           Result.SetKind(tok::lessquestionequal);
@@ -1352,7 +1752,7 @@ LexNextToken:
         CurPtr = ConsumeChar(CurPtr, SizeTmp, Result);
       } else if (Features.CPPMinMax && Char == '?') {
         CurPtr = ConsumeChar(CurPtr, SizeTmp, Result);
-        Diag(Result.getStart(), diag::min_max_deprecated);
+        PP.Diag(Result, diag::min_max_deprecated);
 
         if (getCharAndSize(CurPtr, SizeTmp) == '=') {
           Result.SetKind(tok::greaterquestionequal);  // >?=
@@ -1465,7 +1865,8 @@ LexNextToken:
   }
 
   // Update the end of token position as well as the BufferPtr instance var.
-  Result.SetEnd(BufferPtr = CurPtr);
+  FormTokenWithChars(Result, CurPtr);
+  MIOpt.ReadToken();
 }
 
 }  // namespace tinyclang
\ No newline at end of file
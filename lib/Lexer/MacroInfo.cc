@@ -1,18 +1,82 @@
 #include "tinyclang/Lexer/MacroInfo.h"
 
+#include <cstring>
 #include <iostream>
 
+#include "tinyclang/Lexer/Preprocessor.h"
+#include "tinyclang/Source/SourceManager.h"
+
 namespace tinyclang {
 
 /// dump - Print the macro to stderr, used for debugging.
 ///
-void MacroInfo::dump(const LangOptions& Features) const {
+void MacroInfo::dump(const SourceManager& SourceMgr,
+                     const LangOptions& Features) const {
   std::cerr << "MACRO: ";
-  for (unsigned i = 0, e = ReplacementTokens.size(); i != e; ++i) {
-    ReplacementTokens[i].dump(Features);
+  if (!isBodyLexed) {
+    std::cerr << "<" << RawBodyLength << " bytes not lexed>\n";
+    return;
+  }
+  for (unsigned i = 0, e = NumTokens; i != e; ++i) {
+    getReplacementToken(i).dump(SourceMgr, Features);
     std::cerr << "  ";
   }
   std::cerr << "\n";
 }
 
+/// getTrimmedRawBody - Return the raw body of the macro without the whitespace
+/// around it, as [Start, End).
+static void getTrimmedRawBody(const MacroInfo& MI, const SourceManager& SM,
+                              const char*& Start, const char*& End) {
+  Start = SM.getCharacterData(MI.getRawBodyLoc());
+  End = Start + MI.getRawBodyLength();
+  while (Start != End && (*Start == ' ' || *Start == '\t'))
+    ++Start;
+  while (End != Start && (End[-1] == ' ' || End[-1] == '\t'))
+    --End;
+}
+
+/// isIdenticalTo - Return true if the specified macro has the same parameters
+/// and body as this one: the same tokens with the same whitespace separation.
+/// Bodies that haven't been lexed are lexed if their text differs.
+bool MacroInfo::isIdenticalTo(MacroInfo& Other, Preprocessor& PP) {
+  if (IsFunctionLike != Other.IsFunctionLike ||
+      IsC99Varargs != Other.IsC99Varargs ||
+      IsGNUVarargs != Other.IsGNUVarargs ||
+      NumArguments != Other.NumArguments)
+    return false;
+  for (unsigned i = 0; i != NumArguments; ++i)
+    if (ArgumentList[i] != Other.ArgumentList[i])
+      return false;
+
+  // Two #defines of the same text, which is what repeated definitions nearly
+  // always are, can be compared without lexing either.
+  if (hasRawBody() && Other.hasRawBody()) {
+    const char *Start, *End, *OtherStart, *OtherEnd;
+    getTrimmedRawBody(*this, PP.getSourceManager(), Start, End);
+    getTrimmedRawBody(Other, PP.getSourceManager(), OtherStart, OtherEnd);
+    if (End - Start == OtherEnd - OtherStart &&
+        memcmp(Start, OtherStart, End - Start) == 0)
+      return true;
+  }
+
+  if (!isBodyLexed)
+    PP.LexMacroBody(*this);
+  if (!Other.isBodyLexed)
+    PP.LexMacroBody(Other);
+
+  if (NumTokens != Other.NumTokens)
+    return false;
+
+  for (unsigned i = 0; i != NumTokens; ++i) {
+    const LexerToken& A = getReplacementToken(i);
+    const LexerToken& B = Other.getReplacementToken(i);
+    if (A.getKind() != B.getKind() ||
+        A.hasLeadingSpace() != B.hasLeadingSpace() ||
+        PP.getSpelling(A) != PP.getSpelling(B))
+      return false;
+  }
+  return true;
+}
+
 }  // namespace tinyclang
\ No newline at end of file
@@ -1,17 +1,34 @@
 #include "tinyclang/Lexer/MacroExpander.h"
 #include "tinyclang/Lexer/MacroInfo.h"
 #include "tinyclang/Lexer/Preprocessor.h"
+#include "tinyclang/Source/SourceManager.h"
 
 namespace tinyclang {
 
 /// Lex - Lex and return a token from this macro stream.
 void MacroExpander::Lex(LexerToken& Tok) {
+  // A token stream has its tokens ready.  It stays at its tok::eof until the
+  // preprocessor pops it.
+  if (Macro == 0) {
+    Tok = (*Tokens)[FirstToken + CurToken];
+    if (Tok.getKind() == tok::eof)
+      return;
+    ++CurToken;
+    if (Tok.getIdentifierInfo())
+      return PP.HandleIdentifier(Tok);
+    return;
+  }
+
   // Lexing off the end of the macro, pop this macro off the expansion stack.
-  if (CurToken == Macro.getNumTokens())
-    return PP.HandleEndOfMacro(Tok);
+  if (CurToken == NumTokens)
+    return PP.HandleEndOfMacro();
 
-  // Get the next token to return.
-  Tok = Macro.getReplacementToken(CurToken++);
+  // Get the next token to return.  Its location in the macro body is where it
+  // was spelled, give it its own macro location.
+  Tok = (*Tokens)[FirstToken + CurToken];
+  SourceLocation Loc = FirstLoc.getLocWithOffset(CurToken++);
+  PP.getSourceManager().setSpellingLoc(Loc, Tok.getSourceLocation());
+  Tok.SetLocation(Loc);
 
   // If this is the first token, set the lexical properties of the token to
   // match the lexical properties of the macro identifier.
@@ -20,8 +37,8 @@ void MacroExpander::Lex(LexerToken& Tok) {
     Tok.SetFlagValue(LexerToken::LeadingSpace, HasLeadingSpace);
   }
 
-  // Handle recursive expansion!
-  if (Tok.getIdentifierInfo())
+  // Handle recursive expansion!  A cached full expansion has had it already.
+  if (Tok.getIdentifierInfo() && !IsFullyExpanded)
     return PP.HandleIdentifier(Tok);
 
   // Otherwise, return a normal token.
@@ -107,10 +107,12 @@ bool Preprocessor::EvaluateValue(int& Result, LexerToken& PeekTok) {
       Diag(PeekTok, diag::err_pp_expected_value_in_expr);
       return true;
     case tok::numeric_constant: {
-      // FIXME: faster.  FIXME: track signs.
-      std::string Spell = Lexer::getSpelling(PeekTok, getLangOptions());
+      // FIXME: track signs.
+      llvm::SmallVector<char, 32> Spell(PeekTok.getLength() + 1);
+      unsigned Len = getSpelling(PeekTok, &Spell[0]);
+      Spell[Len] = 0;
       // FIXME: COMPUTE integer constants CORRECTLY.
-      Result = atoi(Spell.c_str());
+      Result = atoi(&Spell[0]);
       Lex(PeekTok);
       return false;
     }
@@ -0,0 +1,123 @@
+#include "tinyclang/Lexer/Pragma.h"
+
+#include "tinyclang/Diagnostic/Diagnostic.h"
+#include "tinyclang/Lexer/Preprocessor.h"
+#include "tinyclang/Source/SourceManager.h"
+
+namespace tinyclang {
+
+// Out-of-line destructor to provide a home for the class.
+PragmaHandler::~PragmaHandler() {}
+
+//===----------------------------------------------------------------------===//
+// PragmaNamespace Implementation.
+//===----------------------------------------------------------------------===//
+
+PragmaNamespace::~PragmaNamespace() {
+  for (auto& Entry : Handlers)
+    delete Entry.second;
+}
+
+/// HandlePragma - The identifier of the namespace (or "#pragma" for the root)
+/// has been read, lex the next token and dispatch to the handler registered
+/// for it.  Unknown pragmas are ignored.
+void PragmaNamespace::HandlePragma(Preprocessor& PP, LexerToken& Tok) {
+  // Read the 'namespace' that the directive is in, e.g. STDC.  Do not macro
+  // expand it, the user can have a STDC #define, that should not affect this.
+  PP.LexUnexpandedToken(Tok);
+
+  // Get the handler for this token.  Keywords and identifiers both have an
+  // IdentifierTokenInfo, anything else can't name a pragma.
+  if (Tok.getIdentifierInfo() == 0)
+    return;
+
+  if (PragmaHandler* Handler = FindHandler(Tok.getIdentifierInfo()))
+    Handler->HandlePragma(PP, Tok);
+}
+
+//===----------------------------------------------------------------------===//
+// Preprocessor Pragma Directive Handling.
+//===----------------------------------------------------------------------===//
+
+namespace {
+/// PragmaOnceHandler - "#pragma once" marks the file as atomically included.
+struct PragmaOnceHandler : public PragmaHandler {
+  PragmaOnceHandler(const IdentifierTokenInfo* OnceID)
+      : PragmaHandler(OnceID) {}
+  virtual void HandlePragma(Preprocessor& PP, LexerToken& OnceTok) {
+    PP.HandlePragmaOnce(OnceTok);
+  }
+};
+}  // namespace
+
+/// AddPragmaHandler - Add the specified pragma handler to the preprocessor.
+/// If 'Namespace' is non-null, then it is a token required to exist on the
+/// pragma line before the pragma string starts, e.g. "STDC" or "GCC".
+void Preprocessor::AddPragmaHandler(const char* Namespace,
+                                    PragmaHandler* Handler) {
+  PragmaNamespace* InsertNS = PragmaHandlers;
+
+  // If this is specified to be in a namespace, step down into it.
+  if (Namespace) {
+    IdentifierTokenInfo* NSID = getIdentifierInfo(Namespace);
+
+    // If there is already a pragma handler with the name of this namespace,
+    // we either have an error (directive with the same name as a namespace) or
+    // we already have the namespace to insert into.
+    if (PragmaHandler* Existing = PragmaHandlers->FindHandler(NSID)) {
+      InsertNS = Existing->getIfNamespace();
+      assert(InsertNS != 0 && "Cannot have a pragma namespace and pragma"
+             " handler with the same name!");
+    } else {
+      // Otherwise, this namespace doesn't exist yet, create and insert the
+      // handler for it.
+      InsertNS = new PragmaNamespace(NSID);
+      PragmaHandlers->AddPragma(InsertNS);
+    }
+  }
+
+  // Check to make sure we don't already have a pragma for this identifier.
+  assert(!InsertNS->FindHandler(Handler->getName()) &&
+         "Pragma handler already exists for this identifier!");
+  InsertNS->AddPragma(Handler);
+}
+
+/// RegisterBuiltinPragmas - Install the standard preprocessor pragmas:
+/// #pragma once.
+void Preprocessor::RegisterBuiltinPragmas() {
+  AddPragmaHandler(0, new PragmaOnceHandler(getIdentifierInfo("once")));
+}
+
+/// HandlePragmaDirective - The "#pragma" directive has been parsed.  Lex the
+/// rest of the pragma, passing it to the registered pragma handlers.
+void Preprocessor::HandlePragmaDirective() {
+  ++NumPragma;
+
+  // Invoke the first level of pragma handlers which reads the namespace id.
+  LexerToken Tok;
+  PragmaHandlers->HandlePragma(*this, Tok);
+
+  // If the pragma handler didn't read the rest of the line, consume it now.
+  if (CurLexer->ParsingPreprocessorDirective)
+    DiscardUntilEndOfDirective();
+}
+
+/// HandlePragmaOnce - Handle #pragma once.  OnceTok is the 'once'.
+///
+void Preprocessor::HandlePragmaOnce(LexerToken& OnceTok) {
+  if (IncludeStack.empty()) {
+    Diag(OnceTok, diag::pp_pragma_once_in_main_file);
+    return;
+  }
+
+  // Check to see if this is the last token on the #pragma once line.
+  CheckEndOfDirective("#pragma once");
+
+  // Mark the file as a once-only file now.  Later #includes of it return in
+  // HandleIncludeDirective, before a FileID or Lexer is made for them.
+  if (const FileEntry* File =
+          SourceMgr.getFileEntryForFileID(CurLexer->getCurFileID()))
+    getFileInfo(File).isImport = true;
+}
+
+}  // namespace tinyclang
\ No newline at end of file
@@ -1,10 +1,16 @@
 #include "tinyclang/Lexer/Preprocessor.h"
 
+#include <algorithm>
 #include <iostream>
 
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
 #include "tinyclang/Basic/FileManager.h"
 #include "tinyclang/Diagnostic/Diagnostic.h"
 #include "tinyclang/Lexer/MacroInfo.h"
+#include "tinyclang/Lexer/Pragma.h"
+#include "tinyclang/Lexer/ScratchBuffer.h"
 #include "tinyclang/Source/SourceManager.h"
 
 namespace tinyclang {
@@ -19,6 +25,7 @@ Preprocessor::Preprocessor(Diagnostic& diags, const LangOptions& opts,
       SourceMgr(SM),
       SystemDirIdx(0),
       NoCurDirSearch(false),
+      IdentifierInfo(opts),
       CurLexer(0),
       CurNextDirLookup(0),
       CurMacroExpander(0) {
@@ -27,11 +34,31 @@ Preprocessor::Preprocessor(Diagnostic& diags, const LangOptions& opts,
   NumIf = NumElse = NumEndif = 0;
   NumEnteredSourceFiles = NumMacroExpanded = NumFastMacroExpanded = 0;
   MaxIncludeStackDepth = MaxMacroStackDepth = 0;
-  NumSkipped = 0;
+  NumFnMacroExpanded = NumMacroArgs = NumPreExpandedArgs = 0;
+  NumReusedPreExpandedArgs = 0;
+  NumRawMacroBodies = NumLexedRawMacroBodies = NumMacroRedefinitions = 0;
+  NumExpansionCacheHits = NumExpansionCacheFills = 0;
+  NumSkipped = NumMultiIncludeFileOptzn = 0;
+  NumSearchCacheHits = NumSearchCacheMisses = 0;
+  NumIncluderCacheHits = NumIncluderCacheMisses = 0;
 
   // Macro expansion is enabled.
   DisableMacroExpansion = false;
   SkippingContents = false;
+  LexAgain = false;
+  EmptyMacroFlags = 0;
+  LazyMacroBodies = false;
+  CacheMacroExpansions = false;
+  NumDisabledMacros = 0;
+  MacroDefinitionEpoch = 1;
+
+  Ident__VA_ARGS__ = getIdentifierInfo("__VA_ARGS__");
+  Ident_defined = getIdentifierInfo("defined");
+  ScratchBuf = new ScratchBuffer(SourceMgr);
+
+  // Initialize the pragma handlers.
+  PragmaHandlers = new PragmaNamespace(0);
+  RegisterBuiltinPragmas();
 }
 
 Preprocessor::~Preprocessor() {
@@ -42,6 +69,11 @@ Preprocessor::~Preprocessor() {
     delete IncludeStack.back().TheLexer;
     IncludeStack.pop_back();
   }
+
+  delete ScratchBuf;
+
+  // Release pragma information.
+  delete PragmaHandlers;
 }
 
 /// getFileInfo - Return the PerFileInfo structure for the specified
@@ -52,30 +84,6 @@ Preprocessor::PerFileInfo& Preprocessor::getFileInfo(const FileEntry* FE) {
   return FileInfo[FE->getUID()];
 }
 
-/// AddKeywords - Add all keywords to the symbol table.
-///
-void Preprocessor::AddKeywords() {
-  enum {
-    C90Shift = 0,
-    EXTC90 = 1 << C90Shift,
-    NOTC90 = 2 << C90Shift,
-    C99Shift = 2,
-    EXTC99 = 1 << C99Shift,
-    NOTC99 = 2 << C99Shift,
-    CPPShift = 4,
-    EXTCPP = 1 << CPPShift,
-    NOTCPP = 2 << CPPShift,
-    Mask = 3
-  };
-
-  // Add keywords and tokens for the current language.
-#define KEYWORD(NAME, FLAGS)                                       \
-  AddKeyword(#NAME + 1, tok::kw_##NAME, (FLAGS >> C90Shift) & Mask, \
-             (FLAGS >> C99Shift) & Mask, (FLAGS >> CPPShift) & Mask);
-#define ALIAS(NAME, TOK) AddKeyword(NAME, tok::kw_##TOK, 0, 0, 0);
-#include "tinyclang/Lexer/TokenKind.def"
-}
-
 /// Diag - Forwarding function for diagnostics.  This emits a diagnostic at
 /// the specified LexerToken's location, translating the token's start
 /// position in the current buffer into a SourcePosition object for rendering.
@@ -102,20 +110,33 @@ void Preprocessor::PrintStats() {
   std::cerr << "\n*** Preprocessor Stats:\n";
   std::cerr << FileInfo.size() << " files tracked.\n";
   unsigned NumOnceOnlyFiles = 0, MaxNumIncludes = 0, NumSingleIncludedFiles = 0;
+  unsigned NumGuardedFiles = 0;
   for (unsigned i = 0, e = FileInfo.size(); i != e; ++i) {
     NumOnceOnlyFiles += FileInfo[i].isImport;
+    NumGuardedFiles += FileInfo[i].ControllingMacro != 0;
     if (MaxNumIncludes < FileInfo[i].NumIncludes)
       MaxNumIncludes = FileInfo[i].NumIncludes;
     NumSingleIncludedFiles += FileInfo[i].NumIncludes == 1;
   }
   std::cerr << "  " << NumOnceOnlyFiles << " #import/#pragma once files.\n";
+  std::cerr << "  " << NumGuardedFiles
+            << " files with multiple-include guards.\n";
   std::cerr << "  " << NumSingleIncludedFiles << " included exactly once.\n";
   std::cerr << "  " << MaxNumIncludes << " max times a file is included.\n";
 
   std::cerr << NumDirectives << " directives found:\n";
   std::cerr << "  " << NumDefined << " #define.\n";
+  std::cerr << "    " << NumRawMacroBodies << " macro bodies lexed lazily, "
+            << NumLexedRawMacroBodies << " of them needed.\n";
+  std::cerr << "    " << NumMacroRedefinitions << " macros redefined.\n";
   std::cerr << "  " << NumUndefined << " #undef.\n";
   std::cerr << "  " << NumIncluded << " #include/#include_next/#import.\n";
+  std::cerr << "    " << NumSearchCacheHits << " search path lookups cached, "
+            << NumSearchCacheMisses << " searched.\n";
+  std::cerr << "    " << NumIncluderCacheHits << " includer dir lookups cached, "
+            << NumIncluderCacheMisses << " searched.\n";
+  std::cerr << "    " << NumMultiIncludeFileOptzn
+            << " skipped by the multiple-include optimization.\n";
   std::cerr << "    " << NumEnteredSourceFiles << " source files entered.\n";
   std::cerr << "    " << MaxIncludeStackDepth << " max include stack depth\n";
   std::cerr << "  " << NumIf << " #if/#ifndef/#ifdef.\n";
@@ -128,6 +149,20 @@ void Preprocessor::PrintStats() {
             << " on the fast path.\n";
   if (MaxMacroStackDepth > 1)
     std::cerr << "  " << MaxMacroStackDepth << " max macroexpand stack depth\n";
+  std::cerr << "  " << NumFnMacroExpanded << " function-like, with "
+            << NumMacroArgs << " arguments, " << NumPreExpandedArgs
+            << " pre-expanded, " << NumReusedPreExpandedArgs
+            << " pre-expansions reused.\n";
+  unsigned NumCachedExpansions = NumExpansionCacheHits + NumExpansionCacheFills;
+  std::cerr << "  " << NumCachedExpansions << " from the expansion cache, "
+            << NumExpansionCacheFills << " of them cached there, "
+            << (NumCachedExpansions
+                    ? NumExpansionCacheHits * 100 / NumCachedExpansions
+                    : 0)
+            << "% hit rate.\n";
+  std::cerr << MacroArena.getBytesAllocated() << " bytes of MacroInfo arena, "
+            << MacroTokens.size() * sizeof(LexerToken)
+            << " bytes of macro body tokens.\n";
 }
 
 //===----------------------------------------------------------------------===//
@@ -137,7 +172,7 @@ void Preprocessor::PrintStats() {
 /// LookupFile - Given a "foo" or <foo> reference, look up the indicated file,
 /// return null on failure.  isAngled indicates whether the file reference is
 /// for system #include's or not (i.e. using <> instead of "").
-const FileEntry* Preprocessor::LookupFile(const std::string& Filename,
+const FileEntry* Preprocessor::LookupFile(llvm::StringRef Filename,
                                           bool isSystem,
                                           const DirectoryLookup* FromDir,
                                           const DirectoryLookup*& NextDir) {
@@ -162,8 +197,20 @@ const FileEntry* Preprocessor::LookupFile(const std::string& Filename,
     const FileEntry* CurFE =
         SourceMgr.getFileEntryForFileID(CurLexer->getCurFileID());
     if (CurFE) {
-      if (const FileEntry* FE =
-              FileMgr.getFile(CurFE->getDir()->getName() + "/" + Filename)) {
+      const DirectoryEntry* CurDir = CurFE->getDir();
+      auto Inserted = IncluderDirCache[CurDir].try_emplace(Filename, nullptr);
+      const FileEntry*& FE = Inserted.first->second;
+      if (Inserted.second) {
+        ++NumIncluderCacheMisses;
+        llvm::SmallString<256> Path(CurDir->getName());
+        Path += '/';
+        Path += Filename;
+        FE = FileMgr.getFile(Path);
+      } else {
+        ++NumIncluderCacheHits;
+      }
+
+      if (FE) {
         if (CurNextDirLookup)
           NextDir = CurNextDirLookup;
         else
@@ -181,18 +228,38 @@ const FileEntry* Preprocessor::LookupFile(const std::string& Filename,
   if (FromDir)
     i = FromDir - &SearchDirs[0];
 
+  // If we have searched for this name from this directory before, the answer
+  // is the same as last time.
+  if (i >= SearchDirCache.size())
+    SearchDirCache.resize(i + 1);
+  auto Inserted = SearchDirCache[i].try_emplace(Filename);
+  LookupFileCacheInfo& CacheInfo = Inserted.first->second;
+  if (!Inserted.second) {
+    ++NumSearchCacheHits;
+    if (CacheInfo.File)
+      NextDir = &SearchDirs[CacheInfo.HitIdx + 1];
+    return CacheInfo.File;
+  }
+  ++NumSearchCacheMisses;
+
   // Check each directory in sequence to see if it contains this file.
+  llvm::SmallString<256> Path;
   for (; i != SearchDirs.size(); ++i) {
     // Concatenate the requested file onto the directory.
     // FIXME: should be in sys::Path.
-    if (const FileEntry* FE = FileMgr.getFile(
-            SearchDirs[i].getDir()->getName() + "/" + Filename)) {
+    Path = SearchDirs[i].getDir()->getName();
+    Path += '/';
+    Path += Filename;
+    if (const FileEntry* FE = FileMgr.getFile(Path)) {
       NextDir = &SearchDirs[i + 1];
+      CacheInfo.File = FE;
+      CacheInfo.HitIdx = i;
       return FE;
     }
   }
 
-  // Otherwise, didn't find it.
+  // Otherwise, didn't find it.  Remember that too.
+  CacheInfo.HitIdx = i;
   return 0;
 }
 
@@ -219,32 +286,184 @@ void Preprocessor::EnterSourceFile(unsigned FileID,
   CurNextDirLookup = NextDir;
 }
 
-/// EnterMacro - Add a Macro to the top of the include stack and start lexing
-/// tokens from it instead of the current buffer.
-void Preprocessor::EnterMacro(LexerToken& Tok) {
-  IdentifierTokenInfo* Identifier = Tok.getIdentifierInfo();
-  MacroInfo& MI = *Identifier->getMacroInfo();
-  SourceLocation ExpandLoc = Tok.getSourceLocation();
-  unsigned MacroID = SourceMgr.getMacroID(Identifier, ExpandLoc);
+/// PushIncludeMacroStack - Save the lexer we are lexing from, if any, on the
+/// include stack, to start lexing from the new macro expander on top of
+/// MacroStack.
+void Preprocessor::PushIncludeMacroStack() {
   if (CurLexer) {
     IncludeStack.push_back(IncludeStackInfo(CurLexer, CurNextDirLookup));
     CurLexer = 0;
     CurNextDirLookup = 0;
-  } else if (CurMacroExpander) {
-    MacroStack.push_back(CurMacroExpander);
   }
+  CurMacroExpander = &MacroStack.back();
 
-  if (MaxMacroStackDepth < MacroStack.size())
-    MaxMacroStackDepth = MacroStack.size();
+  // The depth doesn't count the expander being lexed from.
+  if (MaxMacroStackDepth < MacroStack.size() - 1)
+    MaxMacroStackDepth = MacroStack.size() - 1;
+}
 
-  // TODO: Figure out arguments.
+/// PopMacroStack - Pop the macro expander on top of MacroStack, and go back to
+/// lexing from the one below it or the lexer it was entered from.
+void Preprocessor::PopMacroStack() {
+  MacroStack.pop_back();
+  if (!MacroStack.empty()) {
+    CurMacroExpander = &MacroStack.back();
+    return;
+  }
+
+  CurMacroExpander = 0;
+  // There is no lexer below it if it was entered after the end of the main
+  // file.
+  if (!IncludeStack.empty()) {
+    CurLexer = IncludeStack.back().TheLexer;
+    CurNextDirLookup = IncludeStack.back().TheDirLookup;
+    IncludeStack.pop_back();
+  }
+}
+
+/// EnterMacro - Add a Macro to the top of the include stack and start lexing
+/// tokens from it instead of the current buffer.
+void Preprocessor::EnterMacro(LexerToken& Tok, MacroInfo& MI,
+                              const std::vector<LexerToken>& Toks,
+                              unsigned FirstToken, unsigned NumTokens,
+                              bool FullyExpanded) {
+  unsigned FirstEndedMacro = EndedMacros.size();
+  unsigned ReleaseTokensTo =
+      &Toks == &MacroExpansionTokens ? FirstToken : ~0U;
+
+  // If the expansion on top has no tokens left, all it still has to do is end
+  // right after this one.  Pop it now, and have this one end it, so that a
+  // chain of macros that each expand to the next doesn't stack up.  Its macro
+  // stays disabled until then.
+  if (CurMacroExpander && CurMacroExpander->isAtEnd()) {
+    FirstEndedMacro = CurMacroExpander->getFirstEndedMacro();
+    ReleaseTokensTo =
+        std::min(ReleaseTokensTo, CurMacroExpander->getReleaseTokensTo());
+    EndedMacros.push_back(CurMacroExpander->getMacro());
+    PopMacroStack();
+  }
+
+  SourceLocation FirstLoc =
+      SourceMgr.createExpansionLocs(Tok.getSourceLocation(), NumTokens);
+  MacroStack.emplace_back(MI, Toks, FirstToken, NumTokens, FirstLoc, *this,
+                          Tok.isAtStartOfLine(), Tok.hasLeadingSpace(),
+                          FullyExpanded);
+  MacroStack.back().setEndState(FirstEndedMacro, ReleaseTokensTo);
+  PushIncludeMacroStack();
 
   // Mark the macro as currently disabled, so that it is not recursively
   // expanded.
   MI.DisableMacro();
+  ++NumDisabledMacros;
+}
 
-  CurMacroExpander = new MacroExpander(
-      MI, MacroID, *this, Tok.isAtStartOfLine(), Tok.hasLeadingSpace());
+/// EnterTokenStream - Add a lexer to the top of the include stack that returns
+/// the tokens of Toks from FirstToken up to a tok::eof.
+void Preprocessor::EnterTokenStream(const std::vector<LexerToken>& Toks,
+                                    unsigned FirstToken) {
+  MacroStack.emplace_back(Toks, FirstToken, *this);
+  PushIncludeMacroStack();
+}
+
+/// RemoveTopOfLexerStack - Pop the token stream on top of the include stack,
+/// and go back to lexing from whatever was there before.
+void Preprocessor::RemoveTopOfLexerStack() {
+  assert(CurMacroExpander && CurMacroExpander->getMacro() == 0 &&
+         "Not lexing from a token stream!");
+  PopMacroStack();
+}
+
+/// LexBatch - Lex up to N tokens into Out, stopping after the tok::eof token.
+unsigned Preprocessor::LexBatch(LexerToken* Out, unsigned N) {
+  LexerToken* const End = Out + N;
+  LexerToken* Tok = Out;
+  while (Tok != End) {
+    // Pull tokens from whatever is on top of the stack until it changes.  An
+    // #include, a macro expansion or the end of the buffer all hand lexing off
+    // to something else, and are the only things that do.
+    if (Lexer* L = CurLexer) {
+      do {
+        L->Lex(*Tok);
+        if (LexAgain)
+          LexUntilToken(*Tok);
+      } while (Tok++->getKind() != tok::eof && Tok != End && CurLexer == L);
+    } else {
+      MacroExpander* ME = CurMacroExpander;
+      do {
+        ME->Lex(*Tok);
+        if (LexAgain)
+          LexUntilToken(*Tok);
+      } while (Tok++->getKind() != tok::eof && Tok != End &&
+               CurMacroExpander == ME);
+    }
+    if (Tok[-1].getKind() == tok::eof)
+      return Tok - Out;
+  }
+  return N;
+}
+
+/// LexUntilToken - A callback set LexAgain instead of returning a token in
+/// Result, because it entered or ended a macro expansion.  Lex until a token is
+/// returned.  A macro that expanded to nothing gives the StartOfLine and
+/// LeadingSpace flags of its name to the token returned in its place, unless
+/// that token is on another line.  This handles stuff like "! XX," -> "! ,"
+/// and "   XX," -> "    ,", when XX is empty.
+void Preprocessor::LexUntilToken(LexerToken& Result) {
+  unsigned Flags = 0;
+  do {
+    LexAgain = false;
+    if (EmptyMacroFlags) {
+      // A later empty macro's flags go to the token first, and if that puts it
+      // at the start of a line, the earlier ones' don't.
+      if (EmptyMacroFlags & LexerToken::StartOfLine)
+        Flags = EmptyMacroFlags;
+      else
+        Flags |= EmptyMacroFlags;
+      EmptyMacroFlags = 0;
+    }
+
+    if (CurLexer)
+      CurLexer->Lex(Result);
+    else
+      CurMacroExpander->Lex(Result);
+  } while (LexAgain);
+
+  if (Flags && !Result.isAtStartOfLine()) {
+    if (Flags & LexerToken::StartOfLine)
+      Result.SetFlag(LexerToken::StartOfLine);
+    if (Flags & LexerToken::LeadingSpace)
+      Result.SetFlag(LexerToken::LeadingSpace);
+  }
+}
+
+/// LexMacroBody - Lex the body of a macro that was defined with only the text
+/// of its body recorded.  This is lexed like the rest of the #define line would
+/// have been, by a lexer for the file it is in, which starts right after the
+/// macro name and stops at the end of the last token.
+void Preprocessor::LexMacroBody(MacroInfo& MI) {
+  ++NumLexedRawMacroBodies;
+  SourceLocation BodyLoc = MI.getRawBodyLoc();
+  unsigned FileID = SourceMgr.getFileID(BodyLoc);
+  Lexer BodyLexer(SourceMgr.getBuffer(FileID), FileID, *this);
+  BodyLexer.BufferPtr = BodyLexer.getBufferLocation(BodyLoc);
+  BodyLexer.IsAtStartOfLine = false;
+  BodyLexer.ParsingPreprocessorDirective = true;
+  const char* BodyEnd = BodyLexer.BufferPtr + MI.getRawBodyLength();
+
+  bool OldVal = DisableMacroExpansion;
+  DisableMacroExpansion = true;
+
+  MI.StartLexedBody();
+  LexerToken Tok;
+  while (BodyLexer.BufferPtr != BodyEnd) {
+    assert(BodyLexer.BufferPtr < BodyEnd && "Lexed past the end of the body!");
+    BodyLexer.Lex(Tok);
+    if (MI.getNumTokens() == 0)
+      Tok.ClearFlag(LexerToken::LeadingSpace);
+    MI.AddTokenToBody(Tok);
+  }
+
+  DisableMacroExpansion = OldVal;
 }
 
 //===----------------------------------------------------------------------===//
@@ -266,70 +485,16 @@ void Preprocessor::HandleIdentifier(LexerToken& Identifier) {
   // FIXME: Check for poisoning in ITI?
 
   if (MacroInfo* MI = ITI.getMacroInfo()) {
-    if (MI->isEnabled() && !DisableMacroExpansion) {
-      ++NumMacroExpanded;
-      // If we started lexing a macro, enter the macro expansion body.
-      // FIXME: Read/Validate the argument list here!
-
-      // If this macro expands to no tokens, don't bother to push it onto the
-      // expansion stack, only to take it right back off.
-      if (MI->getNumTokens() == 0) {
-        // Ignore this macro use, just return the next token in the current
-        // buffer.
-        bool HadLeadingSpace = Identifier.hasLeadingSpace();
-        bool IsAtStartOfLine = Identifier.isAtStartOfLine();
-
-        Lex(Identifier);
-
-        // If the identifier isn't on some OTHER line, inherit the leading
-        // whitespace/first-on-a-line property of this token.  This handles
-        // stuff like "! XX," -> "! ," and "   XX," -> "    ,", when XX is
-        // empty.
-        if (!Identifier.isAtStartOfLine()) {
-          if (IsAtStartOfLine)
-            Identifier.SetFlag(LexerToken::StartOfLine);
-          if (HadLeadingSpace)
-            Identifier.SetFlag(LexerToken::LeadingSpace);
-        }
-        ++NumFastMacroExpanded;
-        return;
-
-      } else if (MI->getNumTokens() == 1 &&
-                 // Don't handle identifiers, which might need recursive
-                 // expansion.
-                 MI->getReplacementToken(0).getIdentifierInfo() == 0) {
-        // FIXME: Function-style macros only if no arguments?
-
-        // Otherwise, if this macro expands into a single trivially-expanded
-        // token: expand it now.  This handles common cases like
-        // "#define VAL 42".
-
-        // Propagate the isAtStartOfLine/hasLeadingSpace markers of the macro
-        // identifier to the expanded token.
-        bool isAtStartOfLine = Identifier.isAtStartOfLine();
-        bool hasLeadingSpace = Identifier.hasLeadingSpace();
-
-        // Replace the result token.
-        Identifier = MI->getReplacementToken(0);
-
-        // Restore the StartOfLine/LeadingSpace markers.
-        Identifier.SetFlagValue(LexerToken::StartOfLine, isAtStartOfLine);
-        Identifier.SetFlagValue(LexerToken::LeadingSpace, hasLeadingSpace);
-
-        // FIXME: Get correct macro expansion stack location info!
-
-        // Since this is not an identifier token, it can't be macro expanded, so
-        // we're done.
-        ++NumFastMacroExpanded;
-        return;
+    if (!DisableMacroExpansion) {
+      if (MI->isEnabled() && !Identifier.isExpandDisabled()) {
+        if (HandleMacroExpandedIdentifier(Identifier, MI))
+          return;
+      } else {
+        // C99 6.10.3.4p2: the name of a macro that isn't expanded because this
+        // is in its expansion is never expanded, not even where it could be,
+        // like after it is substituted for a parameter.
+        Identifier.SetFlag(LexerToken::DisableExpand);
       }
-
-      // Start expanding the macro (FIXME, pass arguments).
-      EnterMacro(Identifier);
-
-      // Now that the macro is at the top of the include stack, ask the
-      // preprocessor to read the next token from it.
-      return Lex(Identifier);
     }
   }
 
@@ -353,13 +518,24 @@ void Preprocessor::HandleEndOfFile(LexerToken& Result) {
   // SkipExcludedConditionalBlock.  The Lexer will have already have issued
   // errors for the unterminated #if's on the conditional stack.
   if (isSkipping()) {
-    Result.StartToken(CurLexer);
+    Result.StartToken();
     Result.SetKind(tok::eof);
-    Result.SetStart(CurLexer->BufferEnd);
-    Result.SetEnd(CurLexer->BufferEnd);
+    Result.SetLength(0);
+    Result.SetLocation(CurLexer->getSourceLocation(CurLexer->BufferEnd));
     return;
   }
 
+  // See if this file had a controlling macro.  If so, remember it so that later
+  // #includes of it can be skipped while the macro is still defined.
+  if (CurLexer) {  // Not ending a macro, ignore it.
+    if (const IdentifierTokenInfo* ControllingMacro =
+            CurLexer->MIOpt.GetControllingMacroAtEndOfFile()) {
+      if (const FileEntry* FE =
+              SourceMgr.getFileEntryForFileID(CurLexer->getCurFileID()))
+        getFileInfo(FE).ControllingMacro = ControllingMacro;
+    }
+  }
+
   // If this is a #include'd file, pop it off the include stack and continue
   // lexing the #includer file.
   if (!IncludeStack.empty()) {
@@ -371,10 +547,10 @@ void Preprocessor::HandleEndOfFile(LexerToken& Result) {
     return Lex(Result);
   }
 
-  Result.StartToken(CurLexer);
+  Result.StartToken();
   Result.SetKind(tok::eof);
-  Result.SetStart(CurLexer->BufferEnd);
-  Result.SetEnd(CurLexer->BufferEnd);
+  Result.SetLength(0);
+  Result.SetLocation(CurLexer->getSourceLocation(CurLexer->BufferEnd));
 
   // We're done with the #included file.
   delete CurLexer;
@@ -383,24 +559,568 @@ void Preprocessor::HandleEndOfFile(LexerToken& Result) {
 
 /// HandleEndOfMacro - This callback is invoked when the lexer hits the end of
 /// the current macro line.
-void Preprocessor::HandleEndOfMacro(LexerToken& Result) {
+void Preprocessor::HandleEndOfMacro() {
   assert(CurMacroExpander && !CurLexer &&
          "Ending a macro when currently in a #include file!");
 
-  // Mark macro not ignored now that it is no longer being expanded.
-  CurMacroExpander->getMacro().EnableMacro();
-  delete CurMacroExpander;
+  // Mark macro not ignored now that it is no longer being expanded, along with
+  // the ones whose expansions were popped when it was entered.
+  CurMacroExpander->getMacro()->EnableMacro();
+  --NumDisabledMacros;
+  for (unsigned i = CurMacroExpander->getFirstEndedMacro(),
+                e = EndedMacros.size();
+       i != e; ++i) {
+    EndedMacros[i]->EnableMacro();
+    --NumDisabledMacros;
+  }
+  EndedMacros.resize(CurMacroExpander->getFirstEndedMacro());
+
+  // If its expansion was built, it is at the end of the buffer, maybe after
+  // those of the expansions it ends.
+  if (CurMacroExpander->getReleaseTokensTo() != ~0U) {
+    assert((&CurMacroExpander->getTokens() != &MacroExpansionTokens ||
+            CurMacroExpander->getFirstToken() +
+                    CurMacroExpander->getNumTokens() ==
+                MacroExpansionTokens.size()) &&
+           "Macro expansions ending out of order!");
+    MacroExpansionTokens.resize(CurMacroExpander->getReleaseTokensTo());
+  }
 
-  if (!MacroStack.empty()) {
-    // In a nested macro invocation, continue lexing from the macro.
-    CurMacroExpander = MacroStack.back();
-    MacroStack.pop_back();
-    return Lex(Result);
-  } else {
-    CurMacroExpander = 0;
-    // Handle this like a #include file being popped off the stack.
-    return HandleEndOfFile(Result);
+  // Continue lexing from the macro this was nested in, or the file.
+  PopMacroStack();
+  assert((CurLexer || CurMacroExpander) && "Macro wasn't entered from a file!");
+  LexAgain = true;
+}
+
+//===----------------------------------------------------------------------===//
+// Macro Expansion.
+//===----------------------------------------------------------------------===//
+
+/// HandleMacroExpandedIdentifier - The specified identifier names an enabled
+/// macro: expand it.  Either return the token to use in its place in
+/// Identifier, or enter the expansion (or skip an empty one) and set LexAgain.
+/// Return false if this is the name of a function-like macro that isn't
+/// followed by a '(', so it is just an identifier.
+bool Preprocessor::HandleMacroExpandedIdentifier(LexerToken& Identifier,
+                                                 MacroInfo* MI) {
+  if (MI->isFunctionLike() && !isNextPPTokenLParen())
+    return false;
+
+  ++NumMacroExpanded;
+  if (!MI->isLexed())
+    LexMacroBody(*MI);
+
+  // Reading the arguments overwrites Identifier, keep the name.
+  LexerToken MacroName = Identifier;
+
+  // The tokens the macro expands to: usually just its body.
+  const std::vector<LexerToken>* Toks = &MI->getTokenPool();
+  unsigned FirstToken = MI->getFirstTokenIndex();
+  unsigned NumTokens = MI->getNumTokens();
+  bool FullyExpanded = false;
+
+  // Outside of any other expansion, an object-like macro expands to the same
+  // tokens every time, until a macro is defined or undefined.  If it hasn't
+  // been cached in this epoch, expand it into the cache now.
+  if (CacheMacroExpansions && NumDisabledMacros == 0 && !MI->isFunctionLike()) {
+    if (MI->hasCachedExpansion(MacroDefinitionEpoch)) {
+      if (MI->getNumExpansionTokens() != ~0U)
+        ++NumExpansionCacheHits;
+    } else if (isExpansionCacheable(*MI)) {
+      CacheExpansion(*MI);
+    } else {
+      MI->setUncacheableExpansion(MacroDefinitionEpoch);
+    }
+
+    if (MI->getNumExpansionTokens() != ~0U) {
+      Toks = &ExpansionCacheTokens;
+      FirstToken = MI->getFirstExpansionToken();
+      NumTokens = MI->getNumExpansionTokens();
+      FullyExpanded = true;
+
+      // If the expansion started with empty macros that were preceded by
+      // whitespace, the first token has it.
+      if (NumTokens != 0 && ExpansionCacheTokens[FirstToken].hasLeadingSpace())
+        MacroName.SetFlag(LexerToken::LeadingSpace);
+    }
+  }
+
+  if (!FullyExpanded) {
+    MacroArgs Args(MacroArgTokens);
+    if (MI->isFunctionLike()) {
+      ++NumFnMacroExpanded;
+      if (!ReadFunctionLikeMacroArgs(Identifier, *MI, Args))
+        return true;
+    }
+
+    // Substitute the arguments and paste the tokens now.  A body that is a
+    // single token other than an identifier can't involve either.
+    if (MI->hasPaste() ||
+        (MI->getNumArguments() != 0 &&
+         (NumTokens > 1 || (NumTokens == 1 &&
+                            MI->getReplacementToken(0).getIdentifierInfo())))) {
+      Toks = &MacroExpansionTokens;
+      FirstToken = MacroExpansionTokens.size();
+      ExpandFunctionArguments(*MI, Args);
+      NumTokens = MacroExpansionTokens.size() - FirstToken;
+    }
   }
+
+  // If this macro expands to no tokens, don't bother to push it onto the
+  // expansion stack, only to take it right back off.
+  if (NumTokens == 0) {
+    // Ignore this macro use, just return the next token in the current
+    // buffer.  It inherits the leading whitespace/first-on-a-line property of
+    // this token, see LexUntilToken.
+    EmptyMacroFlags =
+        (MacroName.isAtStartOfLine() ? LexerToken::StartOfLine : 0) |
+        (MacroName.hasLeadingSpace() ? LexerToken::LeadingSpace : 0);
+    LexAgain = true;
+    ++NumFastMacroExpanded;
+    return true;
+
+  } else if (NumTokens == 1 &&
+             // Don't handle identifiers, which might need recursive
+             // expansion, unless they have had it.
+             (FullyExpanded || (*Toks)[FirstToken].getIdentifierInfo() == 0)) {
+    // Otherwise, if this macro expands into a single trivially-expanded
+    // token: expand it now.  This handles common cases like
+    // "#define VAL 42" and "#define f() 42".
+    Identifier = (*Toks)[FirstToken];
+    if (Toks == &MacroExpansionTokens)
+      MacroExpansionTokens.pop_back();
+
+    // Propagate the isAtStartOfLine/hasLeadingSpace markers of the macro
+    // identifier to the expanded token.
+    Identifier.SetFlagValue(LexerToken::StartOfLine,
+                            MacroName.isAtStartOfLine());
+    Identifier.SetFlagValue(LexerToken::LeadingSpace,
+                            MacroName.hasLeadingSpace());
+
+    // Give the token the macro location of its expansion here.
+    Identifier.SetLocation(SourceMgr.createExpansionLoc(
+        Identifier.getSourceLocation(), MacroName.getSourceLocation()));
+
+    // Since this is not an identifier token, it can't be macro expanded, so
+    // we're done.
+    ++NumFastMacroExpanded;
+    return true;
+  }
+
+  // Start expanding the macro.
+  EnterMacro(MacroName, *MI, *Toks, FirstToken, NumTokens, FullyExpanded);
+
+  // Now that the macro is at the top of the include stack, have the
+  // preprocessor read the next token from it.
+  LexAgain = true;
+  return true;
+}
+
+/// isExpansionCacheable - Return true if the expansion of the specified
+/// object-like macro can't depend on the tokens around it.  It can if it runs
+/// into a function-like macro, whose arguments can come from after it, or
+/// 'defined', which stops expansion in #if.  ## is left to the usual path,
+/// which diagnoses bad pastes every time.  Macros that don't expand to other
+/// macros aren't worth caching either.
+bool Preprocessor::isExpansionCacheable(MacroInfo& MI) {
+  // Extension tokens are diagnosed every time they are expanded.
+  if (Diags.getDiagnosticLevel(diag::ext_token_used) != Diagnostic::Ignored)
+    return false;
+
+  // Look at the body of each macro the expansion can run into once.  They are
+  // all expanded, so lexing their bodies here only does it a bit early.
+  llvm::SmallVector<MacroInfo*, 8> Worklist;
+  llvm::SmallPtrSet<MacroInfo*, 8> Visited;
+  Worklist.push_back(&MI);
+  Visited.insert(&MI);
+  while (!Worklist.empty()) {
+    MacroInfo* Cur = Worklist.pop_back_val();
+    if (Cur->hasPaste())
+      return false;
+    if (!Cur->isLexed())
+      LexMacroBody(*Cur);
+
+    for (unsigned i = 0, e = Cur->getNumTokens(); i != e; ++i) {
+      IdentifierTokenInfo* II = Cur->getReplacementToken(i).getIdentifierInfo();
+      if (II == 0)
+        continue;
+      if (II == Ident_defined)
+        return false;
+      MacroInfo* Next = II->getMacroInfo();
+      if (Next == 0)
+        continue;
+      if (Next->isFunctionLike())
+        return false;
+      if (Visited.insert(Next).second)
+        Worklist.push_back(Next);
+    }
+  }
+
+  // A body that names no other macro is as quick to expand as to copy.
+  return Visited.size() > 1;
+}
+
+/// CacheExpansion - Fully expand the specified object-like macro into
+/// ExpansionCacheTokens.  The body is lexed as a token stream of its own with
+/// the macro disabled, which is what expanding it does, but the expansion stops
+/// at the end of the body.  Each token keeps the file location it was spelled
+/// at.
+void Preprocessor::CacheExpansion(MacroInfo& MI) {
+  unsigned BodyStart = MacroExpansionTokens.size();
+  for (unsigned i = 0, e = MI.getNumTokens(); i != e; ++i)
+    MacroExpansionTokens.push_back(MI.getReplacementToken(i));
+  LexerToken Tok;
+  Tok.StartToken();
+  Tok.SetKind(tok::eof);
+  Tok.SetLength(0);
+  Tok.SetLocation(MI.getDefinitionLoc());
+  MacroExpansionTokens.push_back(Tok);
+
+  MI.DisableMacro();
+  ++NumDisabledMacros;
+  EnterTokenStream(MacroExpansionTokens, BodyStart);
+  unsigned Start = ExpansionCacheTokens.size();
+  while (1) {
+    Lex(Tok);
+    if (Tok.getKind() == tok::eof)
+      break;
+    Tok.SetLocation(SourceMgr.getSpellingLoc(Tok.getSourceLocation()));
+    ExpansionCacheTokens.push_back(Tok);
+  }
+  RemoveTopOfLexerStack();
+  --NumDisabledMacros;
+  MI.EnableMacro();
+  MacroExpansionTokens.resize(BodyStart);
+
+  // An empty macro at the end of the body that was preceded by whitespace
+  // gives it to the token after the expansion, which the cache can't.
+  unsigned NumTokens = ExpansionCacheTokens.size() - Start;
+  if (Tok.hasLeadingSpace()) {
+    ExpansionCacheTokens.resize(Start);
+    MI.setUncacheableExpansion(MacroDefinitionEpoch);
+    return;
+  }
+
+  // Reuse the slice of an expansion cached in an earlier epoch if it fits.
+  ++NumExpansionCacheFills;
+  if (NumTokens <= MI.getExpansionCapacity()) {
+    std::copy(ExpansionCacheTokens.begin() + Start, ExpansionCacheTokens.end(),
+              ExpansionCacheTokens.begin() + MI.getFirstExpansionToken());
+    ExpansionCacheTokens.resize(Start);
+    MI.setCachedExpansion(MacroDefinitionEpoch, MI.getFirstExpansionToken(),
+                          NumTokens, MI.getExpansionCapacity());
+    return;
+  }
+  MI.setCachedExpansion(MacroDefinitionEpoch, Start, NumTokens, NumTokens);
+}
+
+/// isNextPPTokenLParen - Return true if the next token is a '('.  The end of a
+/// macro expansion is looked through to the tokens after it (C99 6.10.3.4p1),
+/// but the end of a file isn't.  This consumes nothing.
+bool Preprocessor::isNextPPTokenLParen() {
+  unsigned Val;
+  if (CurLexer)
+    Val = CurLexer->isNextPPTokenLParen();
+  else if (CurMacroExpander)
+    Val = CurMacroExpander->isNextTokenLParen();
+  else
+    return false;
+  if (Val != 2 || CurLexer)
+    return Val == 1;
+
+  // Look through the expansions that are ending, then into the file the
+  // outermost one is in.
+  for (unsigned i = MacroStack.size() - 1; i != 0; --i) {
+    Val = MacroStack[i - 1].isNextTokenLParen();
+    if (Val != 2)
+      return Val == 1;
+  }
+  return !IncludeStack.empty() &&
+         IncludeStack.back().TheLexer->isNextPPTokenLParen() == 1;
+}
+
+/// ReadFunctionLikeMacroArgs - The name of a function-like macro has been read
+/// and the next token is a '('.  Read the arguments of the invocation into
+/// Args.  If they are bad, diagnose them and return false with the token to
+/// return in place of the expansion in MacroName.
+bool Preprocessor::ReadFunctionLikeMacroArgs(LexerToken& MacroName,
+                                             MacroInfo& MI, MacroArgs& Args) {
+  std::vector<LexerToken>& ArgTokens = Args.getTokens();
+  unsigned NumParams = MI.getNumArguments();
+
+  LexerToken Tok;
+  LexUnexpandedToken(Tok);
+  assert(Tok.getKind() == tok::l_paren && "Invocation doesn't start with (!");
+
+  // Commas in parentheses don't separate arguments, and neither do the ones
+  // in the variadic argument, which takes the rest of them.
+  unsigned NumParens = 0;
+  Args.StartArgument();
+  while (1) {
+    LexUnexpandedToken(Tok);
+    tok::TokenKind Kind = Tok.getKind();
+    if (Kind == tok::r_paren) {
+      if (NumParens == 0)
+        break;
+      --NumParens;
+    } else if (Kind == tok::l_paren) {
+      ++NumParens;
+    } else if (Kind == tok::comma && NumParens == 0 &&
+               !(MI.isVariadic() && Args.getNumArguments() == NumParams)) {
+      Args.EndArgument(Tok.getSourceLocation());
+      Args.StartArgument();
+      continue;
+    } else if (Kind == tok::eof || Kind == tok::eom) {
+      // The invocation has to end before the file or directive does.
+      Diag(MacroName, diag::err_unterm_macro_invoc);
+      MacroName = Tok;
+      return false;
+    } else if (Tok.getIdentifierInfo() &&
+               Tok.getIdentifierInfo()->getMacroInfo() &&
+               !Tok.getIdentifierInfo()->getMacroInfo()->isEnabled()) {
+      // The expansion of that macro is still being read, so it is not expanded
+      // later either, when this argument is.
+      Tok.SetFlag(LexerToken::DisableExpand);
+    }
+    ArgTokens.push_back(Tok);
+  }
+  Args.EndArgument(Tok.getSourceLocation());
+
+  // "f()" passes one empty argument, or none if f has no parameters.
+  unsigned NumActuals = Args.getNumArguments();
+  if (NumActuals < NumParams) {
+    // As an extension, the variadic argument can be left out altogether.
+    if (NumActuals + 1 == NumParams && MI.isVariadic()) {
+      Diag(Tok, diag::ext_missing_varargs_arg);
+      Args.StartArgument();
+      Args.EndArgument(Tok.getSourceLocation());
+      Args.setVarargsElided();
+    } else {
+      Diag(Tok, diag::err_too_few_args_in_macro_invoc);
+      Lex(MacroName);
+      return false;
+    }
+  } else if (NumActuals > NumParams &&
+             !(NumParams == 0 && Args.isArgumentEmpty(0))) {
+    Diag(Tok, diag::err_too_many_args_in_macro_invoc);
+    Lex(MacroName);
+    return false;
+  }
+
+  // "f()" leaves out the variadic argument if it is the only one.
+  if (NumParams == 1 && MI.isVariadic() && Args.isArgumentEmpty(0))
+    Args.setVarargsElided();
+
+  NumMacroArgs += NumParams;
+  return true;
+}
+
+/// getPreExpArgument - Return the index in MacroArgTokens of the first token of
+/// the specified argument after it has been fully macro expanded, like it is
+/// before it is substituted for its parameter (C99 6.10.3.1).  This is only
+/// done once per argument of an invocation.
+unsigned Preprocessor::getPreExpArgument(MacroArgs& Args, unsigned Arg) {
+  unsigned Start = Args.getPreExpArgument(Arg);
+  if (Start != ~0U) {
+    ++NumReusedPreExpandedArgs;
+    return Start;
+  }
+
+  // An argument that doesn't name a macro is its own pre-expansion.
+  std::vector<LexerToken>& Toks = Args.getTokens();
+  Start = Args.getUnexpArgument(Arg);
+  unsigned i = Start;
+  while (Toks[i].getKind() != tok::eof &&
+         (Toks[i].getIdentifierInfo() == 0 ||
+          Toks[i].getIdentifierInfo()->getMacroInfo() == 0))
+    ++i;
+
+  if (Toks[i].getKind() != tok::eof) {
+    // Lex the argument as a stream of its own, so that expansion stops at its
+    // end, and add what it expands to to the end of the buffer.
+    ++NumPreExpandedArgs;
+    EnterTokenStream(Toks, Start);
+    Start = Toks.size();
+    LexerToken Tok;
+    do {
+      Lex(Tok);
+      Toks.push_back(Tok);
+    } while (Tok.getKind() != tok::eof);
+    RemoveTopOfLexerStack();
+  }
+
+  Args.setPreExpArgument(Arg, Start);
+  return Start;
+}
+
+/// ExpandFunctionArguments - Add the tokens of the expansion of the specified
+/// macro to the end of MacroExpansionTokens: its body, with the arguments
+/// substituted for the parameters, # and ## applied.
+void Preprocessor::ExpandFunctionArguments(MacroInfo& MI, MacroArgs& Args) {
+  std::vector<LexerToken>& Result = MacroExpansionTokens;
+  const std::vector<LexerToken>& ArgToks = Args.getTokens();
+  unsigned NumTokens = MI.getNumTokens();
+
+  // OperandStart - Where the tokens of the last operand added start, which is
+  // what a ## after it pastes.  An empty argument is a placemarker: pasting
+  // it to something gives that something (C99 6.10.3.3p2).
+  unsigned OperandStart = Result.size();
+
+  // PendingSpace - The parameter of an empty argument had whitespace before
+  // it, which goes to the token after it.
+  bool PendingSpace = false;
+
+  for (unsigned i = 0; i != NumTokens; ++i) {
+    LexerToken Tok = MI.getReplacementToken(i);
+    if (Tok.getKind() == tok::hashhash)
+      continue;
+    bool PasteBefore =
+        i != 0 && MI.getReplacementToken(i - 1).getKind() == tok::hashhash;
+    unsigned Start = Result.size();
+
+    int ArgNo;
+    if (Tok.getKind() == tok::hash && MI.isFunctionLike()) {
+      // #define made sure a parameter follows.
+      ArgNo = MI.getArgumentNum(MI.getReplacementToken(++i).getIdentifierInfo());
+      Result.push_back(StringifyArgument(Args, ArgNo));
+      Result.back().SetFlagValue(LexerToken::LeadingSpace,
+                                 Tok.hasLeadingSpace());
+    } else if (Tok.getIdentifierInfo() == 0 ||
+               (ArgNo = MI.getArgumentNum(Tok.getIdentifierInfo())) == -1) {
+      Result.push_back(Tok);
+    } else {
+      // The operands of ## are substituted as they were written, other
+      // arguments after they are fully macro expanded (C99 6.10.3.1).
+      bool PasteAfter = i + 1 != NumTokens &&
+                        MI.getReplacementToken(i + 1).getKind() == tok::hashhash;
+      unsigned Arg = (PasteBefore || PasteAfter)
+                         ? Args.getUnexpArgument(ArgNo)
+                         : getPreExpArgument(Args, ArgNo);
+
+      // GNU extension: in ", ## __VA_ARGS__", the ## deletes the comma if the
+      // variadic argument was left out, and does nothing otherwise.  Like GCC,
+      // this goes for any comma the left operand ends with, and the argument
+      // keeps its own whitespace instead of the parameter's.
+      bool GNUCommaPaste = false;
+      if (PasteBefore && MI.isVariadic() &&
+          ArgNo + 1 == (int)MI.getNumArguments() && OperandStart != Start &&
+          Result.back().getKind() == tok::comma) {
+        if (Args.isVarargsElided())
+          Result.pop_back();
+        PasteBefore = false;
+        GNUCommaPaste = true;
+        Start = Result.size();
+      }
+
+      for (; ArgToks[Arg].getKind() != tok::eof; ++Arg) {
+        LexerToken ArgTok = ArgToks[Arg];
+        ArgTok.SetLocation(SourceMgr.getSpellingLoc(ArgTok.getSourceLocation()));
+        // An argument can span lines, its expansion doesn't.
+        if (ArgTok.isAtStartOfLine()) {
+          ArgTok.ClearFlag(LexerToken::StartOfLine);
+          ArgTok.SetFlag(LexerToken::LeadingSpace);
+        }
+        Result.push_back(ArgTok);
+      }
+
+      // The first token of the argument goes where the parameter was.
+      if (!GNUCommaPaste) {
+        if (Result.size() != Start)
+          Result[Start].SetFlagValue(LexerToken::LeadingSpace,
+                                     Tok.hasLeadingSpace());
+        else if (Tok.hasLeadingSpace())
+          PendingSpace = true;
+      }
+    }
+
+    if (PendingSpace && Result.size() != Start) {
+      Result[Start].SetFlag(LexerToken::LeadingSpace);
+      PendingSpace = false;
+    }
+
+    if (PasteBefore) {
+      if (OperandStart != Start && Result.size() != Start)
+        PasteTokens(Result, Start);
+      Start = OperandStart;
+    }
+    OperandStart = Start;
+  }
+}
+
+/// StringifyArgument - Implement C99 6.10.3.2: return a string literal token
+/// that spells the specified argument as it was written.
+LexerToken Preprocessor::StringifyArgument(MacroArgs& Args, unsigned Arg) {
+  const std::vector<LexerToken>& Toks = Args.getTokens();
+  unsigned Start = Args.getUnexpArgument(Arg);
+
+  std::string Result = "\"";
+  for (unsigned i = Start; Toks[i].getKind() != tok::eof; ++i) {
+    const LexerToken& Tok = Toks[i];
+    // Whitespace between tokens becomes one space.
+    if (i != Start && (Tok.hasLeadingSpace() || Tok.isAtStartOfLine()))
+      Result += ' ';
+
+    // A " or \ in a string or character literal is escaped.
+    std::string Str = getSpelling(Tok);
+    if (Tok.getKind() == tok::string_literal ||
+        Tok.getKind() == tok::wide_string_literal ||
+        Tok.getKind() == tok::char_constant) {
+      for (unsigned j = 0, e = Str.size(); j != e; ++j) {
+        if (Str[j] == '"' || Str[j] == '\\')
+          Result += '\\';
+        Result += Str[j];
+      }
+    } else {
+      Result += Str;
+    }
+  }
+  Result += '"';
+
+  LexerToken Tok;
+  Tok.StartToken();
+  Tok.SetKind(tok::string_literal);
+  Tok.SetLength(Result.size());
+  Tok.SetLocation(ScratchBuf->getToken(Result.data(), Result.size()));
+  return Tok;
+}
+
+/// PasteTokens - Implement C99 6.10.3.3: replace Toks[RHS-1] and Toks[RHS] with
+/// the token their spellings form together.  If they don't form one token,
+/// diagnose it and leave them alone.
+void Preprocessor::PasteTokens(std::vector<LexerToken>& Toks, unsigned RHS) {
+  std::string Buf = getSpelling(Toks[RHS - 1]) + getSpelling(Toks[RHS]);
+
+  // Lex the pasted text out of the scratch buffer like the rest of a #define
+  // line, so the lexer stops at the newline after it.  It is only one token if
+  // that is where the token ends.  A comment isn't a token at all.
+  LexerToken Result;
+  bool isInvalid =
+      Buf.size() >= 2 && Buf[0] == '/' && (Buf[1] == '/' || Buf[1] == '*');
+  if (!isInvalid) {
+    SourceLocation Loc = ScratchBuf->getToken(Buf.data(), Buf.size());
+    unsigned FileID = SourceMgr.getFileID(Loc);
+    Lexer PasteLexer(SourceMgr.getBuffer(FileID), FileID, *this);
+    PasteLexer.BufferPtr = PasteLexer.getBufferLocation(Loc);
+    PasteLexer.IsAtStartOfLine = false;
+    PasteLexer.ParsingPreprocessorDirective = true;
+    const char* End = PasteLexer.BufferPtr + Buf.size();
+
+    bool OldVal = DisableMacroExpansion;
+    DisableMacroExpansion = true;
+    PasteLexer.Lex(Result);
+    DisableMacroExpansion = OldVal;
+
+    isInvalid = Result.getKind() == tok::eom || PasteLexer.BufferPtr != End;
+  }
+
+  if (isInvalid) {
+    Diag(Toks[RHS - 1], diag::err_pp_bad_paste, Buf);
+    return;
+  }
+
+  Result.SetFlagValue(LexerToken::LeadingSpace, Toks[RHS - 1].hasLeadingSpace());
+  Toks[RHS - 1] = Result;
+  Toks.erase(Toks.begin() + RHS);
 }
 
 //===----------------------------------------------------------------------===//
@@ -468,7 +1188,7 @@ void Preprocessor::CheckEndOfDirective(const char* DirType) {
 /// is true, then #else directives are ok, if not, then we have already seen one
 /// so a #else directive is a duplicate.  When this returns, the caller can lex
 /// the first valid token.
-void Preprocessor::SkipExcludedConditionalBlock(const char* IfTokenLoc,
+void Preprocessor::SkipExcludedConditionalBlock(SourceLocation IfTokenLoc,
                                                 bool FoundNonSkipPortion,
                                                 bool FoundElse) {
   ++NumSkipped;
@@ -490,6 +1210,8 @@ void Preprocessor::SkipExcludedConditionalBlock(const char* IfTokenLoc,
   SkippingContents = true;
   LexerToken Tok;
   while (1) {
+    // Step over the lines that can't be directives without lexing them.
+    CurLexer->SkipToPossibleDirective();
     CurLexer->Lex(Tok);
 
     // If this is the end of the buffer, we have an error.  The lexer will have
@@ -522,27 +1244,45 @@ void Preprocessor::SkipExcludedConditionalBlock(const char* IfTokenLoc,
     // to spell an i/e in a strange way that is another letter.  Skipping this
     // allows us to avoid computing the spelling for #define/#undef and other
     // common directives.
-    char FirstChar = Tok.getStart()[0];
+    const char* TokStart = CurLexer->getBufferLocation(Tok.getSourceLocation());
+    char FirstChar = TokStart[0];
     if (FirstChar >= 'a' && FirstChar <= 'z' && FirstChar != 'i' &&
         FirstChar != 'e') {
       CurLexer->ParsingPreprocessorDirective = false;
       continue;
     }
 
-    // Strip out trigraphs and embedded newlines.
-    std::string Directive = Lexer::getSpelling(Tok, Features);
-    FirstChar = Directive[0];
-    if (FirstChar == 'i' && Directive[1] == 'f') {
-      if (Directive == "if" || Directive == "ifdef" || Directive == "ifndef") {
+    // Find out which directive this is.  Identifiers aren't looked up while
+    // skipping, so ask the keyword table directly.
+    tok::PPKeywordKind Directive;
+    if (!Tok.needsCleaning()) {
+      Directive = IdentifierTable::getPPKeywordID(TokStart,
+                                                  TokStart + Tok.getLength());
+    } else {
+      // Strip out trigraphs and embedded newlines.  The cleaned spelling is no
+      // longer than the raw one.
+      llvm::SmallVector<char, 32> Spelling(Tok.getLength());
+      unsigned Len = CurLexer->getSpelling(Tok, &Spelling[0]);
+      Directive = IdentifierTable::getPPKeywordID(&Spelling[0],
+                                                  &Spelling[0] + Len);
+    }
+
+    bool DoneSkipping = false;
+    switch (Directive) {
+      default:
+        break;
+      case tok::pp_if:
+      case tok::pp_ifdef:
+      case tok::pp_ifndef:
         // We know the entire #if/#ifdef/#ifndef block will be skipped, don't
         // bother parsing the condition.
         DiscardUntilEndOfDirective();
-        CurLexer->pushConditionalLevel(Tok.getStart(), /*wasskipping*/ true,
+        CurLexer->pushConditionalLevel(Tok.getSourceLocation(),
+                                       /*wasskipping*/ true,
                                        /*foundnonskip*/ false,
                                        /*fnddelse*/ false);
-      }
-    } else if (FirstChar == 'e') {
-      if (Directive == "endif") {
+        break;
+      case tok::pp_endif: {
         CheckEndOfDirective("#endif");
         PPConditionalInfo CondInfo;
         CondInfo.WasSkipping = true;  // Silence bogus warning.
@@ -550,15 +1290,27 @@ void Preprocessor::SkipExcludedConditionalBlock(const char* IfTokenLoc,
         assert(!InCond && "Can't be skipping if not in a conditional!");
 
         // If we popped the outermost skipping block, we're done skipping!
-        if (!CondInfo.WasSkipping)
-          break;
-      } else if (Directive == "else") {
+        if (!CondInfo.WasSkipping) {
+          // If this was the top-level conditional of the file, let the
+          // multiple-include optimization know.
+          if (CurLexer->getConditionalStackDepth() == 0)
+            CurLexer->MIOpt.ExitTopLevelConditional();
+          DoneSkipping = true;
+        }
+        break;
+      }
+      case tok::pp_else: {
         // #else directive in a skipping conditional.  If not in some other
         // skipping conditional, and if #else hasn't already been seen, enter it
         // as a non-skipping conditional.
         CheckEndOfDirective("#else");
         PPConditionalInfo& CondInfo = CurLexer->peekConditionalLevel();
 
+        // A top-level #else means part of the file isn't guarded by the
+        // controlling macro, if any.
+        if (CurLexer->getConditionalStackDepth() == 1)
+          CurLexer->MIOpt.EnterTopLevelConditional();
+
         // If this is a #else with a #else before it, report the error.
         if (CondInfo.FoundElse)
           Diag(Tok, diag::pp_err_else_after_else);
@@ -570,11 +1322,18 @@ void Preprocessor::SkipExcludedConditionalBlock(const char* IfTokenLoc,
         // entered, enter the #else block now.
         if (!CondInfo.WasSkipping && !CondInfo.FoundNonSkip) {
           CondInfo.FoundNonSkip = true;
-          break;
+          DoneSkipping = true;
         }
-      } else if (Directive == "elif") {
+        break;
+      }
+      case tok::pp_elif: {
         PPConditionalInfo& CondInfo = CurLexer->peekConditionalLevel();
 
+        // A top-level #elif means part of the file isn't guarded by the
+        // controlling macro, if any.
+        if (CurLexer->getConditionalStackDepth() == 1)
+          CurLexer->MIOpt.EnterTopLevelConditional();
+
         bool ShouldEnter;
         // If this is in a skipping block or if we're already handled this #if
         // block, don't bother parsing the condition.
@@ -600,10 +1359,13 @@ void Preprocessor::SkipExcludedConditionalBlock(const char* IfTokenLoc,
         // If this condition is true, enter it!
         if (ShouldEnter) {
           CondInfo.FoundNonSkip = true;
-          break;
+          DoneSkipping = true;
         }
+        break;
       }
     }
+    if (DoneSkipping)
+      break;
 
     CurLexer->ParsingPreprocessorDirective = false;
   }
@@ -632,6 +1394,11 @@ void Preprocessor::HandleDirective(LexerToken& Result) {
 
   ++NumDirectives;
 
+  // We are about to read a token.  For the multiple-include optimization FA to
+  // work, we have to remember if we had read any tokens *before* this
+  // pp-directive.
+  bool ReadAnyTokensBeforeDirective = CurLexer->MIOpt.getHasReadAnyTokensVal();
+
   // Read the next token, the directive flavor.
   LexUnexpandedToken(Result);
 
@@ -646,78 +1413,45 @@ void Preprocessor::HandleDirective(LexerToken& Result) {
     // FIXME: implement # 7 line numbers!
     break;
 #endif
-    case tok::kw_else:
-      return HandleElseDirective(Result);
-    case tok::kw_if:
-      return HandleIfDirective(Result);
-    case tok::identifier:
-      // Strip out trigraphs and embedded newlines.
-      std::string Directive = Lexer::getSpelling(Result, Features);
-      bool isExtension = false;
-      switch (Directive.size()) {
-        case 4:
-          if (Directive == "line")
-            ;
-          if (Directive == "elif")
-            return HandleElifDirective(Result);
-          if (Directive == "sccs") {
-            isExtension = true;
-            // SCCS is the same as #ident.
-          }
-          break;
-        case 5:
-          if (Directive == "endif")
-            return HandleEndifDirective(Result);
-          if (Directive == "ifdef")
-            return HandleIfdefDirective(Result, false);
-          if (Directive == "undef")
-            return HandleUndefDirective(Result);
-          if (Directive == "error")
-            return HandleUserDiagnosticDirective(Result, false);
-          if (Directive == "ident")
-            isExtension = true;
-          break;
-        case 6:
-          if (Directive == "define")
-            return HandleDefineDirective(Result);
-          if (Directive == "ifndef")
-            return HandleIfdefDirective(Result, true);
-          if (Directive == "import")
-            return HandleImportDirective(Result);
-          if (Directive == "pragma") {
-            // FIXME: implement #pragma
-            ++NumPragma;
-#if 1
-            // Read the rest of the PP line.
-            do {
-              Lex(Result);
-            } while (Result.getKind() != tok::eom);
-
-            return;
-#endif
-          } else if (Directive == "assert") {
-            isExtension = true;
-          }
-          break;
-        case 7:
-          if (Directive == "include")  // Handle #include.
-            return HandleIncludeDirective(Result);
-          if (Directive == "warning") {
-            Diag(Result, diag::ext_pp_warning_directive);
-            return HandleUserDiagnosticDirective(Result, true);
-          }
-          break;
-        case 8:
-          if (Directive == "unassert") {
-            isExtension = true;
-          }
-          break;
-        case 12:
-          if (Directive == "include_next")  // Handle #include_next.
-            return HandleIncludeNextDirective(Result);
-          break;
-      }
-      break;
+  }
+
+  // Keywords and identifiers both know which directive they name, if any.
+  if (IdentifierTokenInfo* II = Result.getIdentifierInfo()) {
+    switch (II->getPPKeywordID()) {
+      default:
+        break;
+      case tok::pp_if:
+        return HandleIfDirective(Result);
+      case tok::pp_ifdef:
+        return HandleIfdefDirective(Result, false,
+                                    ReadAnyTokensBeforeDirective);
+      case tok::pp_ifndef:
+        return HandleIfdefDirective(Result, true, ReadAnyTokensBeforeDirective);
+      case tok::pp_elif:
+        return HandleElifDirective(Result);
+      case tok::pp_else:
+        return HandleElseDirective(Result);
+      case tok::pp_endif:
+        return HandleEndifDirective(Result);
+      case tok::pp_define:
+        return HandleDefineDirective(Result);
+      case tok::pp_undef:
+        return HandleUndefDirective(Result);
+      case tok::pp_include:
+        return HandleIncludeDirective(Result);
+      case tok::pp_include_next:
+        return HandleIncludeNextDirective(Result);
+      case tok::pp_import:
+        return HandleImportDirective(Result);
+      case tok::pp_pragma:
+        return HandlePragmaDirective();
+      case tok::pp_error:
+        return HandleUserDiagnosticDirective(Result, false);
+      case tok::pp_warning:
+        Diag(Result, diag::ext_pp_warning_directive);
+        return HandleUserDiagnosticDirective(Result, true);
+      // FIXME: #line, and the #ident/#sccs and #assert/#unassert extensions.
+    }
   }
 
   // If we reached here, the preprocessing token is not valid!
@@ -763,26 +1497,28 @@ void Preprocessor::HandleIncludeDirective(LexerToken& IncludeTok,
   if (IncludeStack.size() == MaxAllowedIncludeStackDepth - 1)
     return Diag(FilenameTok, diag::err_pp_include_too_deep);
 
-  // Get the text form of the filename.
-  std::string Filename = CurLexer->getSpelling(FilenameTok);
+  // Get the text form of the filename, into a stack buffer unless it is long.
+  llvm::SmallVector<char, 128> FilenameBuffer(FilenameTok.getLength());
+  unsigned FilenameLen = getSpelling(FilenameTok, &FilenameBuffer[0]);
+  llvm::StringRef Filename(&FilenameBuffer[0], FilenameLen);
   assert(!Filename.empty() && "Can't have tokens with empty spellings!");
 
   // Make sure the filename is <x> or "x".
   bool isAngled;
   if (Filename[0] == '<') {
     isAngled = true;
-    if (Filename[Filename.size() - 1] != '>')
+    if (Filename.back() != '>')
       return Diag(FilenameTok, diag::err_pp_expects_filename);
   } else if (Filename[0] == '"') {
     isAngled = false;
-    if (Filename[Filename.size() - 1] != '"')
+    if (Filename.back() != '"')
       return Diag(FilenameTok, diag::err_pp_expects_filename);
   } else {
     return Diag(FilenameTok, diag::err_pp_expects_filename);
   }
 
   // Remove the quotes.
-  Filename = std::string(Filename.begin() + 1, Filename.end() - 1);
+  Filename = Filename.substr(1, Filename.size() - 2);
 
   // Diagnose #include "" as invalid.
   if (Filename.empty())
@@ -813,6 +1549,14 @@ void Preprocessor::HandleIncludeDirective(LexerToken& IncludeTok,
       return;
   }
 
+  // If the file is wrapped in a multiple-include guard whose macro is still
+  // defined, entering it again would produce nothing.  Don't even create a
+  // FileID for it.
+  if (FileInfo.ControllingMacro && FileInfo.ControllingMacro->getMacroInfo()) {
+    ++NumMultiIncludeFileOptzn;
+    return;
+  }
+
   // Look up the file, create a File ID for it.
   unsigned FileID =
       SourceMgr.createFileID(File, FilenameTok.getSourceLocation());
@@ -853,6 +1597,95 @@ void Preprocessor::HandleImportDirective(LexerToken& ImportTok) {
   return HandleIncludeDirective(ImportTok, 0, true);
 }
 
+/// ReadMacroDefinitionArgList - The '(' that starts the parameter list of a
+/// function-like macro has just been read.  Read the parameters up to the ')'
+/// into MI.  Return true on error, with Tok the token that was bad.
+bool Preprocessor::ReadMacroDefinitionArgList(MacroInfo* MI, LexerToken& Tok) {
+  llvm::SmallVector<IdentifierTokenInfo*, 32> Arguments;
+
+  while (1) {
+    LexUnexpandedToken(Tok);
+    switch (Tok.getKind()) {
+      case tok::r_paren:
+        // Found the end of the argument list.  "()" is fine, "(A,)" is not.
+        if (Arguments.empty())
+          return false;
+        Diag(Tok, diag::err_pp_expected_ident_in_arg_list);
+        return true;
+      case tok::ellipsis:  // #define X(... -> C99 varargs
+        if (!Features.C99)
+          Diag(Tok, diag::ext_variadic_macro);
+
+        // Lex the token after the identifier.
+        LexUnexpandedToken(Tok);
+        if (Tok.getKind() != tok::r_paren) {
+          Diag(Tok, diag::err_pp_missing_rparen_in_macro_def);
+          return true;
+        }
+        // Add the __VA_ARGS__ identifier as an argument.
+        Arguments.push_back(Ident__VA_ARGS__);
+        MI->setIsC99Varargs();
+        MI->setArgumentList(Arguments.data(), Arguments.size(), MacroArena);
+        return false;
+      case tok::eom:  // #define X(
+        Diag(Tok, diag::err_pp_missing_rparen_in_macro_def);
+        return true;
+      default:
+        break;
+    }
+
+    // Handle keywords and identifiers here to accept things like
+    // #define Foo(for) for.
+    IdentifierTokenInfo* II = Tok.getIdentifierInfo();
+    if (II == 0) {
+      // #define X(1
+      Diag(Tok, diag::err_pp_expected_ident_in_arg_list);
+      return true;
+    }
+
+    // If this is already used as an argument, it is used multiple times (e.g.
+    // #define X(A,A.
+    if (std::find(Arguments.begin(), Arguments.end(), II) != Arguments.end()) {
+      Diag(Tok, diag::err_pp_duplicate_name_in_arg_list, II->getName());
+      return true;
+    }
+
+    // Add the argument to the macro info.
+    Arguments.push_back(II);
+
+    // Lex the token after the identifier.
+    LexUnexpandedToken(Tok);
+
+    switch (Tok.getKind()) {
+      default:  // #define X(A B
+        Diag(Tok, diag::err_pp_expected_comma_in_arg_list);
+        return true;
+      case tok::r_paren:  // #define X(A)
+        MI->setArgumentList(Arguments.data(), Arguments.size(), MacroArena);
+        return false;
+      case tok::comma:  // #define X(A,
+        break;
+      case tok::ellipsis:  // #define X(A... -> GCC extension
+        // Diagnose extension.
+        Diag(Tok, diag::ext_named_variadic_macro);
+
+        // Lex the token after the identifier.
+        LexUnexpandedToken(Tok);
+        if (Tok.getKind() != tok::r_paren) {
+          Diag(Tok, diag::err_pp_missing_rparen_in_macro_def);
+          return true;
+        }
+
+        MI->setIsGNUVarargs();
+        MI->setArgumentList(Arguments.data(), Arguments.size(), MacroArena);
+        return false;
+      case tok::eom:  // #define X(A
+        Diag(Tok, diag::err_pp_missing_rparen_in_macro_def);
+        return true;
+    }
+  }
+}
+
 /// HandleDefineDirective - Implements #define.  This consumes the entire macro
 /// line then lets the caller lex the next real token.
 ///
@@ -865,7 +1698,23 @@ void Preprocessor::HandleDefineDirective(LexerToken& DefineTok) {
   if (MacroNameTok.getKind() == tok::eom)
     return;
 
-  MacroInfo* MI = new MacroInfo(MacroNameTok.getSourceLocation());
+  MacroInfo* MI =
+      new (MacroArena) MacroInfo(MacroNameTok.getSourceLocation(), MacroTokens);
+
+  // If the body can be lexed later, all there is to do is remember where it
+  // is.  Extension tokens are diagnosed when they are lexed, so only do this
+  // if those diagnostics are off.
+  if (LazyMacroBodies && CurLexer &&
+      Diags.getDiagnosticLevel(diag::ext_token_used) == Diagnostic::Ignored) {
+    const char* BodyStart = CurLexer->BufferPtr;
+    if (const char* BodyEnd = CurLexer->SkipRawMacroBody()) {
+      ++NumRawMacroBodies;
+      MI->setRawBody(CurLexer->getSourceLocation(BodyStart),
+                     BodyEnd - BodyStart);
+      DiscardUntilEndOfDirective();
+      return DefineMacro(MacroNameTok, MI);
+    }
+  }
 
   LexerToken Tok;
   LexUnexpandedToken(Tok);
@@ -873,10 +1722,18 @@ void Preprocessor::HandleDefineDirective(LexerToken& DefineTok) {
   if (Tok.getKind() == tok::eom) {
     // If there is no body to this macro, we have no special handling here.
   } else if (Tok.getKind() == tok::l_paren && !Tok.hasLeadingSpace()) {
-    // This is a function-like macro definition.
-    // assert(0 && "Function-like macros not implemented!");
-    return DiscardUntilEndOfDirective();
+    // This is a function-like macro definition.  Read the argument list.
+    MI->setIsFunctionLike();
+    if (ReadMacroDefinitionArgList(MI, Tok)) {
+      // Forget about MI, it is in the arena.
+      if (Tok.getKind() != tok::eom)
+        DiscardUntilEndOfDirective();
+      return;
+    }
 
+    // Read the first token after the arg list for down below.
+    LexUnexpandedToken(Tok);
+    Tok.ClearFlag(LexerToken::LeadingSpace);
   } else if (!Tok.hasLeadingSpace()) {
     // C99 requires whitespace between the macro definition and the body.  Emit
     // a diagnostic for something like "#define X+".
@@ -896,22 +1753,60 @@ void Preprocessor::HandleDefineDirective(LexerToken& DefineTok) {
   while (Tok.getKind() != tok::eom) {
     MI->AddTokenToBody(Tok);
 
-    // FIXME: See create_iso_definition.
+    // In a function-like macro, # has to be followed by a parameter, which it
+    // stringizes (C99 6.10.3.2p1).
+    if (Tok.getKind() == tok::hash && MI->isFunctionLike()) {
+      LexerToken HashTok = Tok;
+      LexUnexpandedToken(Tok);
+      if (Tok.getIdentifierInfo() == 0 ||
+          MI->getArgumentNum(Tok.getIdentifierInfo()) == -1) {
+        Diag(HashTok, diag::err_pp_stringize_not_parameter);
+        if (Tok.getKind() != tok::eom)
+          DiscardUntilEndOfDirective();
+        return;
+      }
+      continue;
+    }
 
     // Get the next token of the macro.
     LexUnexpandedToken(Tok);
   }
 
-  // Finally, if this identifier already had a macro defined for it, verify that
-  // the macro bodies are identical and free the old definition.
-  if (MacroInfo* OtherMI = MacroNameTok.getIdentifierInfo()->getMacroInfo()) {
-    // FIXME: Verify the definition is the same.
-    // Macros must be identical.  This means all tokes and whitespace separation
-    // must be the same.
-    delete OtherMI;
+  // ## can't be the first or last token of the body (C99 6.10.3.3p1).
+  if (MI->hasPaste()) {
+    if (MI->getReplacementToken(0).getKind() == tok::hashhash) {
+      Diag(MI->getReplacementToken(0), diag::err_paste_at_start);
+      return;
+    }
+    if (MI->getReplacementToken(MI->getNumTokens() - 1).getKind() ==
+        tok::hashhash) {
+      Diag(MI->getReplacementToken(MI->getNumTokens() - 1),
+           diag::err_paste_at_end);
+      return;
+    }
+  }
+
+  DefineMacro(MacroNameTok, MI);
+}
+
+/// DefineMacro - Make MI the definition of the macro named by MacroNameTok.
+///
+void Preprocessor::DefineMacro(const LexerToken& MacroNameTok, MacroInfo* MI) {
+  IdentifierTokenInfo* II = MacroNameTok.getIdentifierInfo();
+
+  // If this identifier already had a macro defined for it, verify that the
+  // macro bodies are identical.  This means all tokens and whitespace
+  // separation must be the same.  The old definition stays in the arena.
+  if (MacroInfo* OldMI = II->getMacroInfo()) {
+    ++NumMacroRedefinitions;
+    if (!OldMI->isIdenticalTo(*MI, *this)) {
+      Diag(MacroNameTok, diag::pp_macro_redefined, II->getName());
+      Diag(OldMI->getDefinitionLoc(), diag::pp_macro_previous_definition);
+    }
   }
 
-  MacroNameTok.getIdentifierInfo()->setMacroInfo(MI);
+  II->setMacroInfo(MI);
+  ++MacroDefinitionEpoch;
 }
 
 /// HandleUndefDirective - Implements #undef.
@@ -940,15 +1835,18 @@ void Preprocessor::HandleUndefDirective(LexerToken& UndefTok) {
     _cpp_warn_if_unused_macro (pfile, node, NULL);
 #endif
 
-  // Free macro definition.
-  delete MI;
+  // The definition stays in the arena, just forget it.
   MacroNameTok.getIdentifierInfo()->setMacroInfo(0);
+  ++MacroDefinitionEpoch;
 }
 
 /// HandleIfdefDirective - Implements the #ifdef/#ifndef directive.  isIfndef is
-/// true when this is a #ifndef directive.
+/// true when this is a #ifndef directive.  ReadAnyTokensBeforeDirective is true
+/// if any tokens have been returned or pp-directives activated before this
+/// #ifndef has been lexed.
 ///
-void Preprocessor::HandleIfdefDirective(LexerToken& Result, bool isIfndef) {
+void Preprocessor::HandleIfdefDirective(LexerToken& Result, bool isIfndef,
+                                        bool ReadAnyTokensBeforeDirective) {
   ++NumIf;
   LexerToken DirectiveTok = Result;
 
@@ -962,14 +1860,25 @@ void Preprocessor::HandleIfdefDirective(LexerToken& Result, bool isIfndef) {
   // Check to see if this is the last token on the #if[n]def line.
   CheckEndOfDirective("#ifdef");
 
+  // If this is the start of a top-level #ifndef with nothing before it, it may
+  // be a multiple-include guard.  Any other top-level conditional means part of
+  // the file isn't covered by one.
+  if (CurLexer->getConditionalStackDepth() == 0) {
+    if (isIfndef && !ReadAnyTokensBeforeDirective)
+      CurLexer->MIOpt.EnterTopLevelIFNDEF(MacroNameTok.getIdentifierInfo());
+    else
+      CurLexer->MIOpt.EnterTopLevelConditional();
+  }
+
   // Should we include the stuff contained by this directive?
   if (!MacroNameTok.getIdentifierInfo()->getMacroInfo() == isIfndef) {
     // Yes, remember that we are inside a conditional, then lex the next token.
-    CurLexer->pushConditionalLevel(DirectiveTok.getStart(), /*wasskip*/ false,
-                                   /*foundnonskip*/ true, /*foundelse*/ false);
+    CurLexer->pushConditionalLevel(DirectiveTok.getSourceLocation(),
+                                   /*wasskip*/ false, /*foundnonskip*/ true,
+                                   /*foundelse*/ false);
   } else {
     // No, skip the contents of this block and return the first token after it.
-    SkipExcludedConditionalBlock(DirectiveTok.getStart(),
+    SkipExcludedConditionalBlock(DirectiveTok.getSourceLocation(),
                                  /*Foundnonskip*/ false,
                                  /*FoundElse*/ false);
   }
@@ -983,14 +1892,19 @@ void Preprocessor::HandleIfDirective(LexerToken& IfToken) {
 
   bool ConditionalTrue = EvaluateDirectiveExpression();
 
+  // A top-level #if means part of the file isn't covered by an #ifndef guard.
+  if (CurLexer->getConditionalStackDepth() == 0)
+    CurLexer->MIOpt.EnterTopLevelConditional();
+
   // Should we include the stuff contained by this directive?
   if (ConditionalTrue) {
     // Yes, remember that we are inside a conditional, then lex the next token.
-    CurLexer->pushConditionalLevel(IfToken.getStart(), /*wasskip*/ false,
-                                   /*foundnonskip*/ true, /*foundelse*/ false);
+    CurLexer->pushConditionalLevel(IfToken.getSourceLocation(),
+                                   /*wasskip*/ false, /*foundnonskip*/ true,
+                                   /*foundelse*/ false);
   } else {
     // No, skip the contents of this block and return the first token after it.
-    SkipExcludedConditionalBlock(IfToken.getStart(),
+    SkipExcludedConditionalBlock(IfToken.getSourceLocation(),
                                  /*Foundnonskip*/ false,
                                  /*FoundElse*/ false);
   }
@@ -1009,6 +1923,10 @@ void Preprocessor::HandleEndifDirective(LexerToken& EndifToken) {
     return Diag(EndifToken, diag::err_pp_endif_without_if);
   }
 
+  // If this the end of a top-level #endif, inform MIOpt.
+  if (CurLexer->getConditionalStackDepth() == 0)
+    CurLexer->MIOpt.ExitTopLevelConditional();
+
   assert(!CondInfo.WasSkipping && !isSkipping() &&
          "This code should only be reachable in the non-skipping case!");
 }
@@ -1022,6 +1940,10 @@ void Preprocessor::HandleElseDirective(LexerToken& Result) {
   if (CurLexer->popConditionalLevel(CI))
     return Diag(Result, diag::pp_err_else_without_if);
 
+  // If this is a top-level #else, inform the MIOpt.
+  if (CurLexer->getConditionalStackDepth() == 0)
+    CurLexer->MIOpt.EnterTopLevelConditional();
+
   // If this is a #else with a #else before it, report the error.
   if (CI.FoundElse)
     Diag(Result, diag::pp_err_else_after_else);
@@ -1043,6 +1965,10 @@ void Preprocessor::HandleElifDirective(LexerToken& ElifToken) {
   if (CurLexer->popConditionalLevel(CI))
     return Diag(ElifToken, diag::pp_err_elif_without_if);
 
+  // If this is a top-level #elif, inform the MIOpt.
+  if (CurLexer->getConditionalStackDepth() == 0)
+    CurLexer->MIOpt.EnterTopLevelConditional();
+
   // If this is a #elif with a #else before it, report the error.
   if (CI.FoundElse)
     Diag(ElifToken, diag::pp_err_elif_after_else);
@@ -0,0 +1,51 @@
+#include "tinyclang/Lexer/ScratchBuffer.h"
+
+#include <cstring>
+
+#include "llvm/Support/MemoryBuffer.h"
+#include "tinyclang/Source/SourceManager.h"
+
+namespace tinyclang {
+
+// ScratchBufSize - The size of each chunk of scratch memory.  Slightly less
+// than a page, almost certainly enough for anything. :)
+static const unsigned ScratchBufSize = 4060;
+
+ScratchBuffer::ScratchBuffer(SourceManager& SM)
+    : SourceMgr(SM), CurBuffer(0), BufferSize(0), BytesUsed(0) {}
+
+/// getToken - Copy the specified text into the scratch buffer and return the
+/// location of its first character.
+SourceLocation ScratchBuffer::getToken(const char* Buf, unsigned Len) {
+  // The text and its newline must fit before the null at the end.
+  if (BytesUsed + Len + 1 > BufferSize)
+    AllocScratchBuffer(Len + 1);
+
+  memcpy(CurBuffer + BytesUsed, Buf, Len);
+  CurBuffer[BytesUsed + Len] = '\n';
+
+  SourceLocation Loc = BufferStartLoc.getLocWithOffset(BytesUsed);
+  BytesUsed += Len + 1;
+  return Loc;
+}
+
+/// AllocScratchBuffer - Start a new chunk of at least RequestLen bytes.  The
+/// old one stays in the SourceManager, along with the tokens that refer to it.
+void ScratchBuffer::AllocScratchBuffer(unsigned RequestLen) {
+  if (RequestLen < ScratchBufSize)
+    RequestLen = ScratchBufSize;
+
+  std::unique_ptr<llvm::WritableMemoryBuffer> Buf =
+      llvm::WritableMemoryBuffer::getNewUninitMemBuffer(RequestLen,
+                                                        "<scratch space>");
+  CurBuffer = Buf->getBufferStart();
+  // Whatever isn't handed out yet is blank.
+  memset(CurBuffer, ' ', RequestLen);
+
+  unsigned FileID = SourceMgr.createFileIDForMemBuffer(Buf.release());
+  BufferStartLoc = SourceMgr.getLocForStartOfFile(FileID);
+  BufferSize = RequestLen;
+  BytesUsed = 0;
+}
+
+}  // namespace tinyclang
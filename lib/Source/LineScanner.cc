@@ -0,0 +1,192 @@
+#include "tinyclang/Source/LineScanner.h"
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TINYCLANG_LINESCANNER_X86 1
+#endif
+
+namespace tinyclang {
+
+namespace {
+
+/// scanLinesScalar - The reference implementation: walk the buffer a byte at a
+/// time.
+void scanLinesScalar(const unsigned char* buf, const unsigned char* end,
+                     std::vector<unsigned>& line_offsets) {
+  const unsigned char* start = buf;
+  while (true) {
+    // Skip over the contents of the line.
+    while (*buf != '\n' && *buf != '\r' && *buf != '\0') {
+      ++buf;
+    }
+
+    if (buf[0] == '\n' || buf[0] == '\r') {
+      // If this is \n\r or \r\n, skip both characters.
+      if ((buf[1] == '\n' || buf[1] == '\r') && buf[0] != buf[1]) {
+        ++buf;
+      }
+      ++buf;
+      line_offsets.push_back(buf - start);
+    } else {
+      // Otherwise, this is a null.  If end of file, exit.
+      if (buf == end) {
+        break;
+      }
+      // Otherwise, skip the null.
+      ++buf;
+    }
+  }
+}
+
+#ifdef TINYCLANG_LINESCANNER_X86
+
+/// processCandidates - Apply the scalar line-ending rules to the \n, \r and \0
+/// bytes found by a vector scanner.  Bit i of 'mask' is set if buf[base + i] is
+/// one of them.  'skip' is the offset of the first byte that can still end a
+/// line, which is how the second byte of a \r\n pair (possibly in the next
+/// block) is ignored.  Return true once the terminating NUL is reached.
+inline auto processCandidates(const unsigned char* buf, unsigned size,
+                              unsigned base, uint32_t mask, unsigned& skip,
+                              std::vector<unsigned>& line_offsets) -> bool {
+  while (mask != 0) {
+    unsigned offs = base + __builtin_ctz(mask);
+    mask &= mask - 1;
+    if (offs < skip) {
+      continue;
+    }
+
+    unsigned char c = buf[offs];
+    if (c == '\0') {
+      // An embedded NUL is skipped, the one at the end stops the scan.
+      if (offs == size) {
+        return true;
+      }
+      continue;
+    }
+
+    // If this is \n\r or \r\n, the line ends after both characters.  The byte
+    // after a newline is always readable: at worst it is the terminating NUL.
+    unsigned char next = buf[offs + 1];
+    skip = ((next == '\n' || next == '\r') && next != c) ? offs + 2 : offs + 1;
+    line_offsets.push_back(skip);
+  }
+  return false;
+}
+
+// The vector scanners only ever do aligned loads.  An aligned block never
+// straddles a page, so the bytes before buf_start in the first block and past
+// the terminating NUL in the last one are always safe to read, and they are
+// masked off or never looked at.
+
+__attribute__((target("sse2"))) inline auto specialMaskSSE2(
+    const unsigned char* block) -> uint32_t {
+  __m128i chars = _mm_load_si128(reinterpret_cast<const __m128i*>(block));
+  __m128i hits =
+      _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\n')),
+                                _mm_cmpeq_epi8(chars, _mm_set1_epi8('\r'))),
+                   _mm_cmpeq_epi8(chars, _mm_setzero_si128()));
+  return static_cast<uint32_t>(_mm_movemask_epi8(hits));
+}
+
+__attribute__((target("sse2"))) void scanLinesSSE2(
+    const unsigned char* buf, const unsigned char* end,
+    std::vector<unsigned>& line_offsets) {
+  unsigned size = end - buf;
+  unsigned misalign = reinterpret_cast<uintptr_t>(buf) & 15;
+  const unsigned char* block = buf - misalign;
+  uint32_t mask = specialMaskSSE2(block) >> misalign;
+  unsigned base = 0;
+  unsigned skip = 0;
+  while (!processCandidates(buf, size, base, mask, skip, line_offsets)) {
+    block += 16;
+    base = block - buf;
+    mask = specialMaskSSE2(block);
+  }
+}
+
+__attribute__((target("avx2"))) inline auto specialMaskAVX2(
+    const unsigned char* block) -> uint32_t {
+  __m256i chars = _mm256_load_si256(reinterpret_cast<const __m256i*>(block));
+  __m256i hits = _mm256_or_si256(
+      _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\n')),
+                      _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\r'))),
+      _mm256_cmpeq_epi8(chars, _mm256_setzero_si256()));
+  return static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+}
+
+__attribute__((target("avx2"))) void scanLinesAVX2(
+    const unsigned char* buf, const unsigned char* end,
+    std::vector<unsigned>& line_offsets) {
+  unsigned size = end - buf;
+  unsigned misalign = reinterpret_cast<uintptr_t>(buf) & 31;
+  const unsigned char* block = buf - misalign;
+  uint32_t mask = specialMaskAVX2(block) >> misalign;
+  unsigned base = 0;
+  unsigned skip = 0;
+  while (!processCandidates(buf, size, base, mask, skip, line_offsets)) {
+    block += 32;
+    base = block - buf;
+    mask = specialMaskAVX2(block);
+  }
+}
+
+#endif  // TINYCLANG_LINESCANNER_X86
+
+}  // namespace
+
+auto isLineScanKindSupported(LineScanKind kind) -> bool {
+  switch (kind) {
+    case LineScanKind::Scalar:
+      return true;
+#ifdef TINYCLANG_LINESCANNER_X86
+    case LineScanKind::SSE2:
+      return __builtin_cpu_supports("sse2");
+    case LineScanKind::AVX2:
+      return __builtin_cpu_supports("avx2");
+#endif
+    default:
+      return false;
+  }
+}
+
+auto getBestLineScanKind() -> LineScanKind {
+  static const LineScanKind best_kind = [] {
+    if (isLineScanKindSupported(LineScanKind::AVX2)) {
+      return LineScanKind::AVX2;
+    }
+    if (isLineScanKindSupported(LineScanKind::SSE2)) {
+      return LineScanKind::SSE2;
+    }
+    return LineScanKind::Scalar;
+  }();
+  return best_kind;
+}
+
+void computeLineOffsets(const char* buf_start, const char* buf_end,
+                        std::vector<unsigned>& line_offsets,
+                        LineScanKind kind) {
+  const auto* buf = reinterpret_cast<const unsigned char*>(buf_start);
+  const auto* end = reinterpret_cast<const unsigned char*>(buf_end);
+
+  // Lines average a few dozen bytes in real code; avoid most of the regrowth.
+  line_offsets.reserve(line_offsets.size() + (end - buf) / 32 + 2);
+
+  switch (isLineScanKindSupported(kind) ? kind : LineScanKind::Scalar) {
+#ifdef TINYCLANG_LINESCANNER_X86
+    case LineScanKind::AVX2:
+      scanLinesAVX2(buf, end, line_offsets);
+      break;
+    case LineScanKind::SSE2:
+      scanLinesSSE2(buf, end, line_offsets);
+      break;
+#endif
+    default:
+      scanLinesScalar(buf, end, line_offsets);
+      break;
+  }
+  line_offsets.push_back(end - buf);
+}
+
+}  // namespace tinyclang
\ No newline at end of file
@@ -1,13 +1,108 @@
 #include "tinyclang/Source/SourceManager.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <string>
 
 #include "llvm/Support/Path.h"
 #include "tinyclang/Basic/FileManager.h"
+#include "tinyclang/Source/LineScanner.h"
 
 namespace tinyclang {
 
+namespace {
+
+/// MappedFileBuffer - A file mapped into memory.  The mapping extends past the
+/// end of the file by at least one byte of zeroes, so the buffer is null
+/// terminated even when the file size is a multiple of the page size.
+class MappedFileBuffer : public llvm::MemoryBuffer {
+  std::string Name;
+  void* MapStart;
+  size_t MapSize;
+
+ public:
+  MappedFileBuffer(std::string name, void* map_start, size_t map_size,
+                   size_t file_size)
+      : Name(std::move(name)), MapStart(map_start), MapSize(map_size) {
+    const char* start = static_cast<const char*>(map_start);
+    init(start, start + file_size, /*RequiresNullTerminator=*/true);
+  }
+  ~MappedFileBuffer() override { munmap(MapStart, MapSize); }
+
+  auto getBufferIdentifier() const -> llvm::StringRef override { return Name; }
+  auto getBufferKind() const -> BufferKind override {
+    return MemoryBuffer_MMap;
+  }
+};
+
+/// mapFile - Map the 'size' bytes of the open file 'fd'.  This returns null on
+/// failure.
+auto mapFile(int fd, size_t size, const std::string& name)
+    -> std::unique_ptr<llvm::MemoryBuffer> {
+  // Reserve zeroed pages for the file and its terminator, then map the file
+  // over the front of them.  The tail of the file's last page reads as zeroes
+  // too, so there is a NUL at buffer[size] either way.
+  size_t page_size = sysconf(_SC_PAGESIZE);
+  size_t map_size = (size + page_size) & ~(page_size - 1);
+  void* start = mmap(nullptr, map_size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS,
+                     -1, 0);
+  if (start == MAP_FAILED) {
+    return nullptr;
+  }
+  if (mmap(start, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) ==
+      MAP_FAILED) {
+    munmap(start, map_size);
+    return nullptr;
+  }
+
+  // The lexer walks the buffer front to back exactly once, so ask for
+  // aggressive read-ahead.  Pages already read can be dropped.
+  madvise(start, size, MADV_SEQUENTIAL);
+  return std::make_unique<MappedFileBuffer>(name, start, map_size, size);
+}
+
+/// readFile - Read the 'size' bytes of the open file 'fd' into a new null
+/// terminated heap buffer.  This returns null on failure.
+auto readFile(int fd, size_t size, const std::string& name)
+    -> std::unique_ptr<llvm::MemoryBuffer> {
+  std::unique_ptr<llvm::WritableMemoryBuffer> buffer =
+      llvm::WritableMemoryBuffer::getNewUninitMemBuffer(size, name);
+  if (buffer == nullptr) {
+    return nullptr;
+  }
+  posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+  char* buf = buffer->getBufferStart();
+  size_t bytes_read = 0;
+  while (bytes_read != size) {
+    ssize_t n = read(fd, buf + bytes_read, size - bytes_read);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return nullptr;
+    }
+    if (n == 0) {
+      // The file shrank since it was stat'd.  Treat the rest as NULs, which
+      // the lexer skips.
+      std::memset(buf + bytes_read, 0, size - bytes_read);
+      break;
+    }
+    bytes_read += n;
+  }
+  return buffer;
+}
+
+}  // namespace
+
 SourceManager::~SourceManager() {
   for (auto& file_info : FileInfos) {
     delete file_info.second.Buffer;
@@ -32,13 +127,8 @@ const SourceManager::InfoRec* SourceManager::getInfoRec(
   }
 
   // Nope, get information.
-  const llvm::MemoryBuffer* file;
-  try {
-    file = llvm::MemoryBuffer::getFile(file_ent->getName()).get().get();
-    if (file == nullptr) {
-      return nullptr;
-    }
-  } catch (...) {
+  std::unique_ptr<llvm::MemoryBuffer> file = loadFileBuffer(file_ent);
+  if (file == nullptr) {
     return nullptr;
   }
 
@@ -46,12 +136,59 @@ const SourceManager::InfoRec* SourceManager::getInfoRec(
       *FileInfos.insert(i, std::make_pair(file_ent, FileInfo()));
   auto& info = const_cast<FileInfo&>(entry.second);
 
-  info.Buffer = file;
+  info.Buffer = file.release();
   info.SourceLineCache = nullptr;
   info.NumLines = 0;
+  info.LastLineNo = 0;
   return &entry;
 }
 
+/// loadFileBuffer - Map or read the specified file according to the load
+/// policy.
+auto SourceManager::loadFileBuffer(const FileEntry* file_ent)
+    -> std::unique_ptr<llvm::MemoryBuffer> {
+  int fd = open(file_ent->getName().c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return nullptr;
+  }
+
+  // The FileEntry was stat'd when it was looked up, but the file may have
+  // changed since.  Mapping past the end of a file faults, so ask again.
+  std::unique_ptr<llvm::MemoryBuffer> buffer;
+  struct stat stat_buf;
+  if (fstat(fd, &stat_buf) == 0) {
+    size_t size = stat_buf.st_size;
+    bool map = false;
+    switch (LoadPolicy) {
+      case BufferLoadPolicy::Threshold:
+        map = size >= MapThreshold;
+        break;
+      case BufferLoadPolicy::AlwaysMap:
+        map = true;
+        break;
+      case BufferLoadPolicy::AlwaysRead:
+        break;
+    }
+    // An empty file can't be mapped.  If mapping fails for any other reason,
+    // reading may still work.
+    if (map && size != 0) {
+      buffer = mapFile(fd, size, file_ent->getName());
+    }
+    if (buffer != nullptr) {
+      ++NumFilesMapped;
+      NumBytesMapped += size;
+    } else {
+      buffer = readFile(fd, size, file_ent->getName());
+      if (buffer != nullptr) {
+        ++NumFilesRead;
+        NumBytesRead += size;
+      }
+    }
+  }
+  close(fd);
+  return buffer;
+}
+
 /// createMemBufferInfoRec - Create a new info record for the specified memory
 /// buffer.  This does no caching.
 const SourceManager::InfoRec* SourceManager::createMemBufferInfoRec(
@@ -61,6 +198,7 @@ const SourceManager::InfoRec* SourceManager::createMemBufferInfoRec(
   fi.Buffer = buffer;
   fi.SourceLineCache = nullptr;
   fi.NumLines = 0;
+  fi.LastLineNo = 0;
   MemBufferInfos.push_back(InfoRec(0, fi));
   return &MemBufferInfos.back();
 }
@@ -70,125 +208,147 @@ const SourceManager::InfoRec* SourceManager::createMemBufferInfoRec(
 /// file or some other input source.
 unsigned SourceManager::createFileID(const InfoRec* file,
                                      SourceLocation include_pos) {
-  // If FileEnt is really large (e.g. it's a large .i file), we may not be able
-  // to fit an arbitrary position in the file in the FilePos field.  To handle
-  // this, we create one FileID for each chunk of the file that fits in a
-  // FilePos field.
+  // The FileID owns an offset for each character of the file and one for the
+  // end of the file, so that the EOF token has a location too.  File offsets
+  // must stay clear of the macro location bit.
   unsigned file_size = file->second.Buffer->getBufferSize();
-  if (file_size + 1 < (1 << SourceLocation::FilePosBits)) {
-    FileIDs.push_back(FileIDInfo(include_pos, 0, file));
-    return FileIDs.size();
-  }
-
-  // Create one FileID for each chunk of the file.
-  unsigned result = FileIDs.size() + 1;
-
-  unsigned chunk_no = 0;
-  while (true) {
-    FileIDs.push_back(FileIDInfo(include_pos, chunk_no++, file));
-
-    if (file_size + 1 < (1 << SourceLocation::FilePosBits)) {
-      break;
-    }
-    file_size -= (1 << SourceLocation::FilePosBits);
+  if (file_size >= SourceLocation::MacroIDBit - NextOffset) {
+    return 0;
   }
+  FileIDs.push_back(FileIDInfo(include_pos, NextOffset, file));
+  NextOffset += file_size + 1;
+  return FileIDs.size();
+}
 
-  return result;
+/// getFileIDSlow - Binary search the FileIDs for the one owning the specified
+/// offset, and remember it for the next lookup.
+unsigned SourceManager::getFileIDSlow(unsigned offset) const {
+  ++NumFileIDSearches;
+  assert(offset < NextOffset && "SourceLocation out of range!");
+  auto i = std::upper_bound(FileIDs.begin(), FileIDs.end(), offset,
+                            [](unsigned value, const FileIDInfo& info) {
+                              return value < info.StartOffset;
+                            });
+  LastLookupFileID = i - FileIDs.begin();
+  return LastLookupFileID;
 }
 
 /// getColumnNumber - Return the column # for the specified include position.
-/// this is significantly cheaper to compute than the line number.  This returns
-/// zero if the column number isn't known.
+/// This returns zero if the column number isn't known.
 unsigned SourceManager::getColumnNumber(SourceLocation include_pos) const {
-  unsigned file_id = include_pos.getFileID();
-  if (file_id == 0) {
+  if (!include_pos.isValid()) {
     return 0;
   }
+  auto [file_id, file_pos] = getDecomposedLoc(include_pos);
   FileInfo* file_info = getFileInfo(file_id);
-  unsigned file_pos = getFilePos(include_pos);
-  const llvm::MemoryBuffer* buffer = file_info->Buffer;
-  const char* buf = buffer->getBufferStart();
+  unsigned line_no = findLineNumber(file_info, file_pos);
+  unsigned line_start = file_info->SourceLineCache[line_no - 1];
 
-  unsigned line_start = file_pos;
-  while (line_start && buf[line_start - 1] != '\n' &&
-         buf[line_start - 1] != '\r') {
-    --line_start;
+  // The only newline characters inside a line are the ones that end it.  A
+  // position on the second character of a \r\n or \n\r pair is the start of
+  // its own (empty) line as far as columns go.
+  const char* buf = file_info->Buffer->getBufferStart();
+  if (file_pos != line_start &&
+      (buf[file_pos - 1] == '\n' || buf[file_pos - 1] == '\r')) {
+    return 1;
   }
   return file_pos - line_start + 1;
 }
 
 /// getLineNumber - Given a SourceLocation, return the physical line number
 /// for the position indicated.  This requires building and caching a table of
-/// line offsets for the SourceBuffer, so this is not cheap: use only when
-/// about to emit a diagnostic.
+/// line offsets for the SourceBuffer, so the first query of each file is not
+/// cheap.
 unsigned SourceManager::getLineNumber(SourceLocation include_pos) {
-  FileInfo* file_info = getFileInfo(include_pos.getFileID());
+  auto [file_id, file_pos] = getDecomposedLoc(include_pos);
+  return findLineNumber(getFileInfo(file_id), file_pos);
+}
+
+/// computeLineTable - Build the SourceLineCache of the specified file.
+void SourceManager::computeLineTable(FileInfo* file_info) {
+  const llvm::MemoryBuffer* buffer = file_info->Buffer;
+
+  // Find the file offsets of all of the *physical* source lines.  This does
+  // not look at trigraphs, escaped newlines, or anything else tricky.  This
+  // is very performance sensitive for programs with lots of diagnostics, so
+  // the scan is vectorized when the host supports it.
+  std::vector<unsigned> line_offsets;
 
+  // Line #1 starts at char 0.
+  line_offsets.push_back(0);
+  computeLineOffsets(buffer->getBufferStart(), buffer->getBufferEnd(),
+                     line_offsets);
+
+  // Copy the offsets into the FileInfo structure.
+  file_info->NumLines = line_offsets.size();
+  file_info->SourceLineCache = new unsigned[line_offsets.size()];
+  std::copy(line_offsets.begin(), line_offsets.end(),
+            file_info->SourceLineCache);
+  file_info->LastLineNo = 1;
+}
+
+/// findLineNumber - Return the 1-based physical line number that the specified
+/// offset of the file lands on, building the line table if needed.
+unsigned SourceManager::findLineNumber(FileInfo* file_info,
+                                       unsigned file_pos) const {
   // If this is the first use of line information for this buffer, compute the
-  /// SourceLineCache for it on demand.
+  // SourceLineCache for it on demand.
   if (file_info->SourceLineCache == nullptr) {
-    const llvm::MemoryBuffer* buffer = file_info->Buffer;
-
-    // Find the file offsets of all of the *physical* source lines.  This does
-    // not look at trigraphs, escaped newlines, or anything else tricky.
-    std::vector<unsigned> line_offsets;
-
-    // Line #1 starts at char 0.
-    line_offsets.push_back(0);
-
-    const auto* buf =
-        reinterpret_cast<const unsigned char*>(buffer->getBufferStart());
-    const auto* end =
-        reinterpret_cast<const unsigned char*>(buffer->getBufferEnd());
-    unsigned offs = 0;
-    while (true) {
-      // Skip over the contents of the line.
-      // TODO: Vectorize this?  This is very performance sensitive for programs
-      // with lots of diagnostics.
-      const auto* next_buf = static_cast<const unsigned char*>(buf);
-      while (*next_buf != '\n' && *next_buf != '\r' && *next_buf != '\0') {
-        ++next_buf;
-      }
-      offs += next_buf - buf;
-      buf = next_buf;
-
-      if (buf[0] == '\n' || buf[0] == '\r') {
-        // If this is \n\r or \r\n, skip both characters.
-        if ((buf[1] == '\n' || buf[1] == '\r') && buf[0] != buf[1]) {
-          ++offs, ++buf;
-        }
-        ++offs, ++buf;
-        line_offsets.push_back(offs);
-      } else {
-        // Otherwise, this is a null.  If end of file, exit.
-        if (buf == end) {
-          break;
-        }
-        // Otherwise, skip the null.
-        ++offs, ++buf;
-      }
-    }
-    line_offsets.push_back(offs);
-
-    // Copy the offsets into the FileInfo structure.
-    file_info->NumLines = line_offsets.size();
-    file_info->SourceLineCache = new unsigned[line_offsets.size()];
-    std::copy(line_offsets.begin(), line_offsets.end(),
-              file_info->SourceLineCache);
+    const_cast<SourceManager*>(this)->computeLineTable(file_info);
   }
+  ++NumLineLookups;
 
-  // Okay, we know we have a line number table.  Do a binary search to find the
-  // line number that this character position lands on.
+  // The line number is the number of line starts at or before file_pos.
+  const unsigned* source_line_cache = file_info->SourceLineCache;
   unsigned num_lines = file_info->NumLines;
-  unsigned* source_line_cache = file_info->SourceLineCache;
-
-  // TODO: If this is performance sensitive, we could try doing simple radix
-  // type approaches to make good (tight?) initial guesses based on the
-  // assumption that all lines are the same average size.
-  unsigned* pos =
-      std::lower_bound(source_line_cache, source_line_cache + num_lines,
-                       getFilePos(include_pos) + 1);
-  return pos - source_line_cache;
+  auto is_line_no = [&](unsigned line_no) {
+    return source_line_cache[line_no - 1] <= file_pos &&
+           (line_no == num_lines || source_line_cache[line_no] > file_pos);
+  };
+
+  // Queries come from the lexer, the diagnostics and -E in file order, so they
+  // nearly always land on the line of the last query or the one after it.
+  unsigned line_no = file_info->LastLineNo;
+  if (is_line_no(line_no)) {
+    ++NumLineCacheHits;
+    return line_no;
+  }
+  if (line_no != num_lines && is_line_no(line_no + 1)) {
+    ++NumLineCacheHits;
+    return file_info->LastLineNo = line_no + 1;
+  }
+
+  // Otherwise, search.  Lines in a file are roughly the same length, so
+  // interpolating between the ends of the range makes a good guess.  A few
+  // rounds of that get close; finish with a binary search so that oddly shaped
+  // files can't make this linear.  Throughout, every line start before 'lo' is
+  // <= file_pos and every one at or after 'hi' is > file_pos.
+  unsigned lo = 0;
+  unsigned hi = num_lines;
+  for (unsigned round = 0; round != 4 && hi - lo > 16; ++round) {
+    unsigned lo_offs = source_line_cache[lo];
+    unsigned hi_offs = source_line_cache[hi - 1];
+    if (file_pos < lo_offs) {
+      hi = lo;
+      break;
+    }
+    if (file_pos >= hi_offs) {
+      lo = hi;
+      break;
+    }
+    unsigned guess =
+        lo + static_cast<unsigned>(static_cast<uint64_t>(file_pos - lo_offs) *
+                                   (hi - 1 - lo) / (hi_offs - lo_offs));
+    if (source_line_cache[guess] <= file_pos) {
+      lo = guess + 1;
+    } else {
+      hi = guess;
+    }
+  }
+  line_no = std::upper_bound(source_line_cache + lo, source_line_cache + hi,
+                             file_pos) -
+            source_line_cache;
+  return file_info->LastLineNo = line_no;
 }
 
 /// PrintStats - Print statistics to stderr.
@@ -198,15 +358,22 @@ void SourceManager::PrintStats() const {
   std::cerr << FileInfos.size() << " files mapped, " << MemBufferInfos.size()
             << " mem buffers mapped, " << FileIDs.size()
             << " file ID's allocated.\n";
+  std::cerr << NextOffset - 1 << " bytes of location offset space used, "
+            << NumFileIDLookups << " FileID lookups, " << NumFileIDSearches
+            << " needed a search.\n";
+  std::cerr << MacroLocs.size() << " macro locations allocated ("
+            << MacroLocs.size() * sizeof(MacroLocInfo) << " bytes).\n";
 
   unsigned num_line_nums_computed = 0;
-  unsigned num_file_bytes_mapped = 0;
   for (const auto& file_info : FileInfos) {
     num_line_nums_computed += file_info.second.SourceLineCache != nullptr;
-    num_file_bytes_mapped += file_info.second.Buffer->getBufferSize();
   }
-  std::cerr << num_file_bytes_mapped << " bytes of files mapped, "
-            << num_line_nums_computed << " files with line #'s computed.\n";
+  std::cerr << NumBytesMapped << " bytes of files mapped (" << NumFilesMapped
+            << " files), " << NumBytesRead << " bytes read (" << NumFilesRead
+            << " files).\n";
+  std::cerr << num_line_nums_computed << " files with line #'s computed.\n";
+  std::cerr << NumLineLookups << " line lookups, " << NumLineCacheHits
+            << " answered by the last-line cache.\n";
 }
 
 }  // namespace tinyclang
\ No newline at end of file
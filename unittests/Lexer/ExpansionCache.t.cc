@@ -0,0 +1,98 @@
+#include "PreprocessorTest.h"
+
+#include <cstdio>
+
+namespace {
+
+/// Preprocess - Return what -E prints for Input, with the full expansions of
+/// object-like macros cached or not.  Clear OK if there are diagnostics.
+std::string Preprocess(const tinyclang::TestDirectory& Dir, const char* Name,
+                       const char* Input, bool Cached, bool& OK) {
+  tinyclang::PreprocessorTest Test(Dir);
+  Test.PP.setCacheMacroExpansions(Cached);
+  std::string Output = Test.preprocess(Input);
+  if (!Test.DiagClient.Kinds.empty()) {
+    std::fprintf(stderr, "%s: unexpected diagnostic\n", Name);
+    OK = false;
+  }
+  return Output;
+}
+
+/// CheckCache - Return true if Input gives Expected both with and without the
+/// expansion cache, printing what went wrong if not.
+bool CheckCache(const tinyclang::TestDirectory& Dir, const char* Name,
+                const char* Input, const char* Expected) {
+  bool OK = true;
+  std::string Uncached = Preprocess(Dir, Name, Input, false, OK);
+  std::string Cached = Preprocess(Dir, Name, Input, true, OK);
+  OK &= tinyclang::CheckOutput(Name, Uncached, Expected);
+  OK &= tinyclang::CheckOutput(Name, Cached, Uncached);
+  return OK;
+}
+
+}  // namespace
+
+auto main() -> int {
+  tinyclang::TestDirectory Dir("ExpansionCache");
+
+  // A #define or #undef of any macro makes every cached expansion stale, and
+  // filling it again overwrites it in place.
+  bool OK = CheckCache(Dir, "redefinition",
+                       "#define ONE 1\n"
+                       "#define TWO (ONE + ONE)\n"
+                       "#define FOUR (TWO * TWO)\n"
+                       "a = FOUR; b = FOUR;\n"
+                       "#undef ONE\n"
+                       "#define ONE one\n"
+                       "c = FOUR; d = TWO;\n"
+                       "#undef ONE\n"
+                       "e = FOUR;\n"
+                       "#define ONE 2\n"
+                       "f = FOUR; g = FOUR;\n",
+                       "a = ((1 + 1) * (1 + 1)); b = ((1 + 1) * (1 + 1));\n"
+                       "c = ((one + one) * (one + one)); d = (one + one);\n"
+                       "e = ((ONE + ONE) * (ONE + ONE));\n"
+                       "f = ((2 + 2) * (2 + 2)); g = ((2 + 2) * (2 + 2));\n");
+
+  // A macro isn't expanded inside its own expansion, whether that is cached
+  // or not.
+  OK &= CheckCache(Dir, "self-reference",
+                   "#define A B\n"
+                   "#define B A\n"
+                   "#define SELF SELF + A\n"
+                   "A B A\n"
+                   "SELF SELF\n",
+                   "A B A\n"
+                   "SELF + A SELF + A\n");
+
+  // Uses in #if, in the arguments and body of a function-like macro, and
+  // inside another expansion, which can't fill the cache.
+  OK &= CheckCache(Dir, "other contexts",
+                   "#define ONE 1\n"
+                   "#define TWO (ONE + ONE)\n"
+                   "#define FOUR (TWO * TWO)\n"
+                   "#if FOUR == 4 && TWO\n"
+                   "yes = TWO;\n"
+                   "#else\n"
+                   "no;\n"
+                   "#endif\n"
+                   "#define ID(x) x\n"
+                   "#define CALL(x) x + FOUR\n"
+                   "#define WRAP [FOUR]\n"
+                   "ID(FOUR) CALL(TWO) ID(ID(TWO))\n"
+                   "WRAP FOUR\n",
+                   "yes = (1 + 1);\n"
+                   "((1 + 1) * (1 + 1)) (1 + 1) + ((1 + 1) * (1 + 1)) "
+                   "(1 + 1)\n"
+                   "[((1 + 1) * (1 + 1))] ((1 + 1) * (1 + 1))\n");
+
+  // Empty macros pass their whitespace on to the token after them.
+  OK &= CheckCache(Dir, "empty macros",
+                   "#define ONE 1\n"
+                   "#define TWO (ONE + ONE)\n"
+                   "#define EMPTY\n"
+                   "#define E2 EMPTY EMPTY\n"
+                   "[E2] [EMPTY TWO E2] TWO\n",
+                   "[ ] [ (1 + 1) ] (1 + 1)\n");
+  return OK ? 0 : 1;
+}
@@ -0,0 +1,34 @@
+#include "tinyclang/Lexer/IdentifierTable.h"
+
+#include <cstdio>
+
+#include "tinyclang/Lexer/Lexer.h"
+
+namespace {
+
+/// CheckTokenID - Return true if the named identifier has the specified token
+/// kind, printing it if not.
+bool CheckTokenID(tinyclang::IdentifierTable& Table, const char* Name,
+                  tinyclang::tok::TokenKind Kind) {
+  if (Table.get(Name).getTokenID() == Kind)
+    return true;
+  std::fprintf(stderr, "%s: wrong token kind\n", Name);
+  return false;
+}
+
+}  // namespace
+
+auto main() -> int {
+  tinyclang::LangOptions Options;
+  Options.C99 = 1;
+  tinyclang::IdentifierTable Table(Options);
+
+  // Keywords that are extensions in another language are still keywords here.
+  // Aliases like __attribute__ take the flags of no language.
+  bool OK = CheckTokenID(Table, "_Bool", tinyclang::tok::kw__Bool);
+  OK &= CheckTokenID(Table, "__attribute__", tinyclang::tok::kw___attribute);
+  OK &= CheckTokenID(Table, "__attribute", tinyclang::tok::kw___attribute);
+  OK &= CheckTokenID(Table, "typeof", tinyclang::tok::kw_typeof);
+  OK &= CheckTokenID(Table, "catch", tinyclang::tok::identifier);
+  return OK ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+#include "PreprocessorTest.h"
+
+#include <cstdio>
+
+namespace {
+
+/// CheckLazy - Return true if Input gives Expected and NumRedefined "macro
+/// redefined" warnings, each with its note, both with macro bodies lexed when
+/// they are defined and when they are first expanded.  Print what went wrong
+/// if not.
+bool CheckLazy(const tinyclang::TestDirectory& Dir, const char* Name,
+               const char* Input, const char* Expected,
+               unsigned NumRedefined = 0) {
+  bool OK = true;
+  for (bool Lazy : {false, true}) {
+    tinyclang::PreprocessorTest Test(Dir);
+    Test.PP.setLazyMacroBodies(Lazy);
+    OK &= tinyclang::CheckOutput(Name, Test.preprocess(Input), Expected);
+
+    const tinyclang::RecordingDiagnosticClient& Diags = Test.DiagClient;
+    if (Diags.Kinds.size() != 2 * NumRedefined ||
+        Diags.count(tinyclang::diag::pp_macro_redefined) != NumRedefined ||
+        Diags.count(tinyclang::diag::pp_macro_previous_definition) !=
+            NumRedefined) {
+      std::fprintf(stderr, "%s: wrong diagnostics when %s\n", Name,
+                   Lazy ? "lazy" : "eager");
+      OK = false;
+    }
+  }
+  return OK;
+}
+
+}  // namespace
+
+auto main() -> int {
+  tinyclang::TestDirectory Dir("LazyMacroBodies");
+
+  // Bodies with comments, escaped newlines, literals and odd spacing expand
+  // the same whenever they are lexed.  Most are never expanded.
+  bool OK = CheckLazy(Dir, "bodies",
+                      "#define EMPTY\n"
+                      "#define SPACED   a   +   b   \n"
+                      "#define COMMENT a /* c */ + // d\n"
+                      "#define SPLIT a \\\n"
+                      "  + \\\n"
+                      "b\n"
+                      "#define LITERALS \"s /* t */\" 'c' 1.5e+3 L\"w\"\n"
+                      "#define NESTED SPACED COMMENT\n"
+                      "#define FN(x) x + SPLIT\n"
+                      "#define UNUSED never expanded\n"
+                      "[EMPTY] SPACED; COMMENT; SPLIT;\n"
+                      "LITERALS NESTED FN(1)\n",
+                      "[] a + b; a +; a + b;\n"
+                      "\"s /* t */\" 'c' 1.5e+3 L\"w\" a + b a + 1 + a + b\n");
+
+  // A redefinition is fine if it is the same tokens with whitespace in the
+  // same places, however much of it and whatever kind (C99 6.10.3p2).
+  OK &= CheckLazy(Dir, "identical redefinitions",
+                  "#define A 1 + 2\n"
+                  "#define A 1   +   2\n"
+                  "#define A 1 /* c */ + \\\n"
+                  "  2\n"
+                  "#define F(x) (x + 1)\n"
+                  "#define F(x) (x  +  1)\n"
+                  "A F(3)\n",
+                  "1 + 2 (3 + 1)\n");
+  OK &= CheckLazy(Dir, "whitespace-only difference",
+                  "#define A 1 + 2\n"
+                  "#define A 1+2\n"
+                  "A\n",
+                  "1+2\n", 1);
+  OK &= CheckLazy(Dir, "token difference",
+                  "#define A 1 + 2\n"
+                  "#define A 1 + 3\n"
+                  "#define F(x) x\n"
+                  "#define F(y) y\n"
+                  "A F(4)\n",
+                  "1 + 3 4\n", 2);
+  return OK ? 0 : 1;
+}
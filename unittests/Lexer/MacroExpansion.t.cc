@@ -0,0 +1,161 @@
+#include "PreprocessorTest.h"
+
+#include <cstdio>
+
+namespace {
+
+/// CheckExpansion - Preprocess Input and return true if it gives Expected with
+/// no diagnostics, in particular no bad paste, printing what went wrong if not.
+bool CheckExpansion(const tinyclang::TestDirectory& Dir, const char* Name,
+                    const char* Input, const char* Expected) {
+  tinyclang::PreprocessorTest Test(Dir);
+  bool OK = tinyclang::CheckOutput(Name, Test.preprocess(Input), Expected);
+  if (Test.DiagClient.count(tinyclang::diag::err_pp_bad_paste) != 0) {
+    std::fprintf(stderr, "%s: bad paste\n", Name);
+    OK = false;
+  } else if (!Test.DiagClient.Kinds.empty()) {
+    std::fprintf(stderr, "%s: unexpected diagnostic\n", Name);
+    OK = false;
+  }
+  return OK;
+}
+
+/// CheckBadInvocation - Preprocess Input and return true if it gives Expected
+/// and the one diagnostic ID, printing what went wrong if not.
+bool CheckBadInvocation(const tinyclang::TestDirectory& Dir, const char* Name,
+                        const char* Input, const char* Expected,
+                        tinyclang::diag::kind ID) {
+  tinyclang::PreprocessorTest Test(Dir);
+  bool OK = tinyclang::CheckOutput(Name, Test.preprocess(Input), Expected);
+  if (Test.DiagClient.Kinds.size() != 1 || Test.DiagClient.count(ID) != 1) {
+    std::fprintf(stderr, "%s: wrong diagnostics\n", Name);
+    OK = false;
+  }
+  return OK;
+}
+
+}  // namespace
+
+auto main() -> int {
+  tinyclang::TestDirectory Dir("MacroExpansion");
+
+  // C99 6.10.3.5p5, EXAMPLE 3: rescanning, and nested and recursive uses.
+  bool OK = CheckExpansion(Dir, "EXAMPLE 3",
+                           "#define x 3\n"
+                           "#define f(a) f(x * (a))\n"
+                           "#undef x\n"
+                           "#define x 2\n"
+                           "#define g f\n"
+                           "#define z z[0]\n"
+                           "#define h g(~\n"
+                           "#define m(a) a(w)\n"
+                           "#define w 0,1\n"
+                           "#define t(a) a\n"
+                           "#define p() int\n"
+                           "#define q(x) x\n"
+                           "#define r(x,y) x ## y\n"
+                           "#define str(x) # x\n"
+                           "f(y+1) + f(f(z)) % t(t(g)(0) + t)(1);\n"
+                           "g(x+(3,4)-w) | h 5) & m\n"
+                           "(f)^m(m);\n"
+                           "p() i[q()] = { q(1), r(2,3), r(4,), r(,5), r(,) };\n"
+                           "char c[2][6] = { str(hello), str() };\n",
+                           "f(2 * (y+1)) + f(2 * (f(2 * (z[0])))) % "
+                           "f(2 * (0)) + t(1);\n"
+                           "f(2 * (2+(3,4)-0,1)) | f(2 * (~ 5)) & "
+                           "f(2 * (0,1))^m(0,1);\n"
+                           "int i[] = { 1, 23, 4, 5, };\n"
+                           "char c[2][6] = { \"hello\", \"\" };\n");
+
+  // C99 6.10.3.5p6, EXAMPLE 4: # and ##, and the order they are applied in.
+  // The "\n" outside of a string literal in str(: @\n) is left out, the lexer
+  // rejects a stray backslash.
+  OK &= CheckExpansion(
+      Dir, "EXAMPLE 4",
+      "#define str(s) # s\n"
+      "#define xstr(s) str(s)\n"
+      "#define debug(s, t) printf(\"x\" # s \"= %d, x\" # t \"= %s\", \\\n"
+      " x ## s, x ## t)\n"
+      "#define INCFILE(n) vers ## n\n"
+      "#define glue(a, b) a ## b\n"
+      "#define xglue(a, b) glue(a, b)\n"
+      "#define HIGHLOW \"hello\"\n"
+      "#define LOW LOW \", world\"\n"
+      "debug(1, 2);\n"
+      "fputs(str(strncmp(\"abc\\0d\", \"abc\", '\\4') // this goes away\n"
+      " == 0) str(: @), s);\n"
+      "xstr(INCFILE(2).h)\n"
+      "glue(HIGH, LOW);\n"
+      "xglue(HIGH, LOW)\n",
+      "printf(\"x\" \"1\" \"= %d, x\" \"2\" \"= %s\", x1, x2);\n"
+      "fputs(\"strncmp(\\\"abc\\\\0d\\\", \\\"abc\\\", '\\\\4') == 0\" "
+      "\": @\", s);\n"
+      "\"vers2.h\"\n"
+      "\"hello\";\n"
+      "\"hello\" \", world\"\n");
+
+  // C99 6.10.3.5p7, EXAMPLE 5: placemarkers.
+  OK &= CheckExpansion(Dir, "EXAMPLE 5",
+                       "#define t(x,y,z) x ## y ## z\n"
+                       "int j[] = { t(1,2,3), t(,4,5), t(6,,7), t(8,9,),\n"
+                       " t(10,,), t(,11,), t(,,12), t(,,) };\n",
+                       "int j[] = { 123, 45, 67, 89,\n"
+                       " 10, 11, 12, };\n");
+
+  // C99 6.10.3.5p9, EXAMPLE 7: variable arguments.
+  OK &= CheckExpansion(Dir, "EXAMPLE 7",
+                       "#define debug(...) fprintf(stderr, __VA_ARGS__)\n"
+                       "#define showlist(...) puts(#__VA_ARGS__)\n"
+                       "#define report(test, ...) ((test)?puts(#test):\\\n"
+                       " printf(__VA_ARGS__))\n"
+                       "debug(\"Flag\");\n"
+                       "debug(\"X = %d\\n\", x);\n"
+                       "showlist(The first, second, and third items.);\n"
+                       "report(x>y, \"x is %d but y is %d\", x, y);\n",
+                       "fprintf(stderr, \"Flag\");\n"
+                       "fprintf(stderr, \"X = %d\\n\", x);\n"
+                       "puts(\"The first, second, and third items.\");\n"
+                       "((x>y)?puts(\"x>y\"): "
+                       "printf(\"x is %d but y is %d\", x, y));\n");
+
+  // GNU extension: ", ## __VA_ARGS__" deletes the comma when the variadic
+  // argument is left out, and the argument keeps its own whitespace.
+  OK &= CheckExpansion(Dir, "GNU comma",
+                       "#define w(fmt, ...) p(fmt, ## __VA_ARGS__)\n"
+                       "#define v(...) f(x, ## __VA_ARGS__)\n"
+                       "w(1)\n"
+                       "w(1,)\n"
+                       "w()\n"
+                       "v()\n"
+                       "w(1,2)\n"
+                       "w(1, 2, 3)\n"
+                       "v(a)\n",
+                       "p(1)\n"
+                       "p(1,)\n"
+                       "p()\n"
+                       "f(x)\n"
+                       "p(1,2)\n"
+                       "p(1, 2, 3)\n"
+                       "f(x,a)\n");
+
+  // An argument used more than once is expanded once, and expands the same
+  // every time.
+  OK &= CheckExpansion(Dir, "reused argument",
+                       "#define ONE 1\n"
+                       "#define twice(x) x + x + #x\n"
+                       "twice(ONE)\n",
+                       "1 + 1 + \"ONE\"\n");
+
+  // A bad invocation is diagnosed and dropped.
+  OK &= CheckBadInvocation(Dir, "too many arguments",
+                           "#define f(a) a\n"
+                           "f(1, 2) x\n",
+                           " x\n",
+                           tinyclang::diag::err_too_many_args_in_macro_invoc);
+  OK &= CheckBadInvocation(Dir, "too few arguments",
+                           "#define g(a, b) a b\n"
+                           "g(1) y\n",
+                           " y\n",
+                           tinyclang::diag::err_too_few_args_in_macro_invoc);
+  return OK ? 0 : 1;
+}
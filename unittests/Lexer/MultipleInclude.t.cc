@@ -0,0 +1,87 @@
+#include "PreprocessorTest.h"
+
+#include <cstdio>
+
+namespace {
+
+/// CheckIncludes - Preprocess Input and return true if it gives Expected, and
+/// enters NumFiles files counting itself, printing what went wrong if not.
+bool CheckIncludes(const tinyclang::TestDirectory& Dir, const char* Name,
+                   const char* Input, const char* Expected,
+                   unsigned NumFiles) {
+  tinyclang::PreprocessorTest Test(Dir);
+  bool OK = tinyclang::CheckOutput(Name, Test.preprocess(Input), Expected);
+  if (Test.PP.getNumEnteredSourceFiles() != NumFiles) {
+    std::fprintf(stderr, "%s: %u files entered, expected %u\n", Name,
+                 Test.PP.getNumEnteredSourceFiles(), NumFiles);
+    OK = false;
+  }
+  if (!Test.DiagClient.Kinds.empty()) {
+    std::fprintf(stderr, "%s: unexpected diagnostic\n", Name);
+    OK = false;
+  }
+  return OK;
+}
+
+}  // namespace
+
+auto main() -> int {
+  tinyclang::TestDirectory Dir("MultipleInclude");
+  Dir.write("guarded.h",
+            "#ifndef GUARDED_H\n#define GUARDED_H\nint guarded;\n#endif\n");
+  Dir.write("comments.h",
+            "/* A license block. */\n// And a line comment.\n"
+            "#ifndef COMMENTS_H\n#define COMMENTS_H\nint comments;\n#endif\n"
+            "/* end of comments.h */\n");
+  Dir.write("trailing_tokens.h",
+            "#ifndef TRAILING_TOKENS_H\n#define TRAILING_TOKENS_H\n"
+            "int once;\n#endif\nint every_time;\n");
+  Dir.write("trailing_directive.h",
+            "#ifndef TRAILING_DIRECTIVE_H\n#define TRAILING_DIRECTIVE_H\n"
+            "int once;\n#endif\n#ifdef AGAIN\nint again;\n#endif\n");
+  Dir.write("else.h",
+            "#ifndef ELSE_H\n#define ELSE_H\nint first;\n#else\nint again;\n"
+            "#endif\n");
+  Dir.write("elif.h",
+            "#ifndef ELIF_H\n#define ELIF_H\nint first;\n#elif 1\nint again;\n"
+            "#endif\n");
+
+  // A guarded header is skipped the second time, without being entered.
+  bool OK = CheckIncludes(Dir, "guard",
+                          "#include \"guarded.h\"\n"
+                          "#include \"guarded.h\"\n"
+                          "x\n",
+                          "int guarded;\nx\n", 2);
+  OK &= CheckIncludes(Dir, "comment prologue",
+                      "#include \"comments.h\"\n"
+                      "#include \"comments.h\"\n"
+                      "x\n",
+                      "int comments;\nx\n", 2);
+
+  // Once the guard is undefined, the header has to be read again.
+  OK &= CheckIncludes(Dir, "#undef guard",
+                      "#include \"guarded.h\"\n"
+                      "#undef GUARDED_H\n"
+                      "#include \"guarded.h\"\n",
+                      "int guarded;\nint guarded;\n", 3);
+
+  // Anything outside of the #ifndef block means there is no guard.
+  OK &= CheckIncludes(Dir, "tokens after #endif",
+                      "#include \"trailing_tokens.h\"\n"
+                      "#include \"trailing_tokens.h\"\n",
+                      "int once;\nint every_time;\nint every_time;\n", 3);
+  OK &= CheckIncludes(Dir, "directive after #endif",
+                      "#include \"trailing_directive.h\"\n"
+                      "#define AGAIN\n"
+                      "#include \"trailing_directive.h\"\n",
+                      "int once;\nint again;\n", 3);
+  OK &= CheckIncludes(Dir, "top-level #else",
+                      "#include \"else.h\"\n"
+                      "#include \"else.h\"\n",
+                      "int first;\nint again;\n", 3);
+  OK &= CheckIncludes(Dir, "top-level #elif",
+                      "#include \"elif.h\"\n"
+                      "#include \"elif.h\"\n",
+                      "int first;\nint again;\n", 3);
+  return OK ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+#include "PreprocessorTest.h"
+
+#include <cstdio>
+
+namespace {
+
+/// CheckOnce - Preprocess Input and return true if it gives Expected, enters
+/// NumFiles files counting itself, and reports only NumOnceInMain "#pragma once
+/// in main file" warnings, printing what went wrong if not.
+bool CheckOnce(const tinyclang::TestDirectory& Dir, const char* Name,
+               const char* Input, const char* Expected, unsigned NumFiles,
+               unsigned NumOnceInMain = 0) {
+  tinyclang::PreprocessorTest Test(Dir);
+  bool OK = tinyclang::CheckOutput(Name, Test.preprocess(Input), Expected);
+  if (Test.PP.getNumEnteredSourceFiles() != NumFiles) {
+    std::fprintf(stderr, "%s: %u files entered, expected %u\n", Name,
+                 Test.PP.getNumEnteredSourceFiles(), NumFiles);
+    OK = false;
+  }
+  if (Test.DiagClient.Kinds.size() != NumOnceInMain ||
+      Test.DiagClient.count(tinyclang::diag::pp_pragma_once_in_main_file) !=
+          NumOnceInMain) {
+    std::fprintf(stderr, "%s: wrong diagnostics\n", Name);
+    OK = false;
+  }
+  return OK;
+}
+
+}  // namespace
+
+auto main() -> int {
+  tinyclang::TestDirectory Dir("PragmaOnce");
+  Dir.write("once.h", "#pragma once\nint once;\n");
+  Dir.write("once_late.h", "int before;\n#pragma once\nint after;\n");
+  Dir.write("plain.h", "int plain;\n");
+
+  // A #pragma once header is only read the first time it is included.
+  bool OK = CheckOnce(Dir, "included twice",
+                      "#include \"once.h\"\n"
+                      "#include \"once.h\"\n"
+                      "x\n",
+                      "int once;\nx\n", 2);
+  OK &= CheckOnce(Dir, "not at the start",
+                  "#include \"once_late.h\"\n"
+                  "#include \"once_late.h\"\n",
+                  "int before;\nint after;\n", 2);
+
+  // #import and #pragma once both mean "only once", whichever comes first.
+  OK &= CheckOnce(Dir, "#import then #include",
+                  "#import \"once.h\"\n"
+                  "#include \"once.h\"\n"
+                  "#import \"once.h\"\n",
+                  "int once;\n", 2);
+  OK &= CheckOnce(Dir, "#include then #import",
+                  "#include \"once.h\"\n"
+                  "#import \"once.h\"\n",
+                  "int once;\n", 2);
+  OK &= CheckOnce(Dir, "#import without #pragma once",
+                  "#import \"plain.h\"\n"
+                  "#import \"plain.h\"\n"
+                  "#include \"plain.h\"\n",
+                  "int plain;\n", 2);
+
+  // In the main file, it only warns.
+  OK &= CheckOnce(Dir, "main file",
+                  "#pragma once\n"
+                  "int main_file;\n",
+                  "int main_file;\n", 1, 1);
+  return OK ? 0 : 1;
+}
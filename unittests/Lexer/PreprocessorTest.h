@@ -0,0 +1,138 @@
+#ifndef TINYCLANG_UNITTESTS_LEXER_PREPROCESSORTEST_H
+#define TINYCLANG_UNITTESTS_LEXER_PREPROCESSORTEST_H
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "tinyclang/Basic/FileManager.h"
+#include "tinyclang/Diagnostic/Diagnostic.h"
+#include "tinyclang/Lexer/Preprocessor.h"
+#include "tinyclang/Source/SourceManager.h"
+
+namespace tinyclang {
+
+/// RecordingDiagnosticClient - A DiagnosticClient that remembers the kind of
+/// every diagnostic reported, instead of printing it.
+class RecordingDiagnosticClient : public DiagnosticClient {
+ public:
+  std::vector<diag::kind> Kinds;
+
+  void HandleDiagnostic(Diagnostic::Level, SourceLocation, diag::kind ID,
+                        const std::string&) override {
+    Kinds.push_back(ID);
+  }
+
+  /// count - Return how many times the specified diagnostic was reported.
+  unsigned count(diag::kind ID) const {
+    unsigned N = 0;
+    for (diag::kind K : Kinds)
+      N += K == ID;
+    return N;
+  }
+};
+
+/// TestDirectory - A directory of the test's own under the temporary
+/// directory, which the files the test writes go in.  It is removed when the
+/// test is done with it.
+class TestDirectory {
+  std::filesystem::path Path;
+
+ public:
+  explicit TestDirectory(const char* Name)
+      : Path(std::filesystem::temp_directory_path() /
+             (std::string("tinyclang-") + Name)) {
+    std::filesystem::remove_all(Path);
+    std::filesystem::create_directories(Path);
+  }
+  ~TestDirectory() { std::filesystem::remove_all(Path); }
+
+  std::string getPath() const { return Path.string(); }
+
+  /// write - Write a file with the specified name and contents.
+  void write(const char* Name, const std::string& Text) const {
+    std::ofstream(Path / Name, std::ios::binary) << Text;
+  }
+};
+
+/// PreprocessorTest - A Preprocessor with the driver's language options, which
+/// looks up both kinds of #include in one TestDirectory.  Set its options on
+/// PP, then preprocess one main file with it.
+struct PreprocessorTest {
+  RecordingDiagnosticClient DiagClient;
+  Diagnostic Diags;
+  LangOptions LangOpts;
+  FileManager FileMgr;
+  SourceManager SourceMgr;
+  Preprocessor PP;
+  const TestDirectory& Dir;
+
+  explicit PreprocessorTest(const TestDirectory& dir)
+      : Diags(DiagClient),
+        LangOpts(getLangOptions()),
+        PP(Diags, LangOpts, FileMgr, SourceMgr),
+        Dir(dir) {
+    std::vector<DirectoryLookup> SearchDirs;
+    SearchDirs.push_back(DirectoryLookup(FileMgr.getDirectory(Dir.getPath()),
+                                         DirectoryLookup::NormalHeaderDir,
+                                         true));
+    PP.SetSearchPaths(SearchDirs, 0, false);
+  }
+
+  /// getLangOptions - The options the driver turns on.
+  static LangOptions getLangOptions() {
+    LangOptions Options;
+    Options.Trigraphs = 1;
+    Options.BCPLComment = 1;
+    Options.C99 = 1;
+    Options.DollarIdents = Options.Digraphs = 1;
+    Options.ObjC1 = Options.ObjC2 = 1;
+    return Options;
+  }
+
+  /// preprocess - Write Text to the main file of the TestDirectory, and return
+  /// what -E prints for it.
+  std::string preprocess(const std::string& Text) {
+    Dir.write("main.c", Text);
+    const FileEntry* File = FileMgr.getFile(Dir.getPath() + "/main.c");
+    PP.EnterSourceFile(SourceMgr.createFileID(File, SourceLocation()), 0);
+
+    // Print the tokens the way the driver's -E mode does.
+    std::string Result;
+    LexerToken Tok;
+    bool isFirstToken = true;
+    do {
+      PP.Lex(Tok);
+      if (Tok.isAtStartOfLine()) {
+        if (!isFirstToken)
+          Result += '\n';
+        unsigned ColNo = SourceMgr.getColumnNumber(Tok.getSourceLocation());
+        if (ColNo <= 1 && Tok.getKind() == tok::hash)
+          Result += ' ';
+        for (; ColNo > 1; --ColNo)
+          Result += ' ';
+      } else if (Tok.hasLeadingSpace()) {
+        Result += ' ';
+      }
+      isFirstToken = false;
+      Result += PP.getSpelling(Tok);
+    } while (Tok.getKind() != tok::eof);
+    return Result + '\n';
+  }
+};
+
+/// CheckOutput - Return true if Output is Expected, printing both if not.
+inline bool CheckOutput(const char* What, const std::string& Output,
+                        const std::string& Expected) {
+  if (Output == Expected)
+    return true;
+  std::fprintf(stderr, "%s: expected\n%s\n--- got\n%s\n---\n", What,
+               Expected.c_str(), Output.c_str());
+  return false;
+}
+
+}  // namespace tinyclang
+
+#endif  // TINYCLANG_UNITTESTS_LEXER_PREPROCESSORTEST_H
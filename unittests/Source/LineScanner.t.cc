@@ -0,0 +1,87 @@
+#include "tinyclang/Source/LineScanner.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* const kind_names[] = {"Scalar", "SSE2", "AVX2"};
+
+/// scan - Return the line table of text[start, text.size()).  The string's own
+/// terminator is the NUL the scanners need after the end.
+auto scan(const std::string& text, unsigned start, tinyclang::LineScanKind kind)
+    -> std::vector<unsigned> {
+  std::vector<unsigned> offsets;
+  tinyclang::computeLineOffsets(text.c_str() + start,
+                                text.c_str() + text.size(), offsets, kind);
+  return offsets;
+}
+
+/// checkTable - Return true if the scalar scanner gives 'expected' for text,
+/// printing what went wrong if not.
+auto checkTable(const char* name, const std::string& text,
+                const std::vector<unsigned>& expected) -> bool {
+  if (scan(text, 0, tinyclang::LineScanKind::Scalar) == expected) {
+    return true;
+  }
+  std::fprintf(stderr, "%s: wrong line table\n", name);
+  return false;
+}
+
+/// checkAgrees - Return true if every supported vector scanner gives the same
+/// table as the scalar one for text, starting at each of the first 32 bytes so
+/// that every alignment of the buffer is seen.  Print what went wrong if not.
+auto checkAgrees(const char* name, const std::string& text) -> bool {
+  for (tinyclang::LineScanKind kind :
+       {tinyclang::LineScanKind::SSE2, tinyclang::LineScanKind::AVX2}) {
+    if (!tinyclang::isLineScanKindSupported(kind)) {
+      continue;
+    }
+    for (unsigned start = 0; start != 32 && start <= text.size(); ++start) {
+      if (scan(text, start, kind) !=
+          scan(text, start, tinyclang::LineScanKind::Scalar)) {
+        std::fprintf(stderr, "%s: %s differs from Scalar starting at %u\n",
+                     name, kind_names[static_cast<int>(kind)], start);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+auto main() -> int {
+  // The reference rules: each of \n, \r, \r\n and \n\r ends a line, and
+  // embedded NULs are skipped.
+  bool ok = checkTable("empty", "", {0});
+  ok &= checkTable("no newline", "abc", {3});
+  ok &= checkTable("\\n", "a\nb", {2, 3});
+  ok &= checkTable("\\n\\n", "\n\n", {1, 2, 2});
+  ok &= checkTable("\\r\\n\\n\\r", "\r\n\n\r", {2, 4, 4});
+  ok &= checkTable("\\r\\r\\n", "\r\r\n", {1, 3, 3});
+  ok &= checkTable("\\n\\r\\n", "\n\r\n", {2, 3, 3});
+  ok &= checkTable("embedded NULs", std::string("a\0b\n\0", 5), {4, 5});
+
+  // A long run of every kind of line ending, NULs and ordinary bytes.
+  std::string mixed;
+  for (unsigned i = 0; i != 4096; ++i) {
+    mixed += "xy\r\n\n\r\0\r\r\n"[i * 7 % 11];
+  }
+  ok &= checkAgrees("mixed", mixed);
+  ok &= checkAgrees("NULs",
+                    std::string(100, '\0') + std::string("\n\0\r", 3));
+
+  // Pairs at every position in and across 16- and 32-byte blocks, and
+  // buffers ending at every position in a block.
+  for (unsigned shift = 0; shift != 64; ++shift) {
+    std::string pad(shift, 'x');
+    ok &= checkAgrees("\\r\\n at shift", pad + "\r\n" + mixed.substr(shift));
+    ok &= checkAgrees("\\n\\r at shift", pad + "\n\r" + mixed.substr(shift));
+    ok &= checkAgrees("\\r at end", pad + "\r");
+    ok &= checkAgrees("\\r\\n at end", pad + "\r\n");
+    ok &= checkAgrees("mixed prefix", mixed.substr(0, shift));
+  }
+  return ok ? 0 : 1;
+}